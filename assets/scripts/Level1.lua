@@ -78,8 +78,19 @@ Level1 = {
         tileSize       = 32,
         mapSizeX       = 25,
         mapSizeY       = 20
+        -- terrain flags per tile code of the .map file ("solid", "water", "slow"),
+        -- entities react to them if their transform has: terrain = "solid,water,slow"
+        -- tileFlags   = { ["13"] = "solid", ["25"] = "water,slow" }
     },
 
+    ----------------------------------------------------
+    -- uncomment to add a procedurally generated stress scene
+    -- (N enemies with projectile emitters, M obstacles and
+    -- a random tilemap of mapSizeX * mapSizeY tiles);
+    -- the command line --stress=N,M,WxH[,seed] has priority
+    ----------------------------------------------------
+    -- stress = { enemies = 1000, obstacles = 500, mapSizeX = 200, mapSizeY = 200, seed = 1 },
+
 
     ----------------------------------------------------
     -- table to define entities and their components
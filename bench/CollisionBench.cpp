@@ -0,0 +1,165 @@
+// ==================================================================
+// Filename:    CollisionBench.cpp
+// Description: a benchmark of EntityMgr::CheckCollisions:
+//              the serial path vs the parallel one by number of workers;
+//              also checks that both paths produce the same events
+//
+// Created:     19.10.2026 by DimaSkup
+// ==================================================================
+#include "../src/EntityMgr.h"
+#include "../src/EventMgr.h"
+#include "../src/JobSystem.h"
+#include "../src/GameState.h"
+#include "../src/Components/Transform.h"
+#include "../src/Components/Collider.h"
+#include <chrono>
+#include <random>
+#include <vector>
+
+GameStates g_GameStates;
+
+// events which are generated by collision tests: [type, entity ID]
+struct CollisionEvent
+{
+    eEventType type;
+    EntityID   id;
+};
+
+std::vector<CollisionEvent> s_Events;
+
+template <typename T>
+void RecordEvent(void* pUserData, const T& e)
+{
+    s_Events.push_back({ T::TYPE, e.id });
+}
+
+constexpr int NUM_DYNAMIC   = 4000;
+constexpr int NUM_STATIC    = 2000;
+constexpr int NUM_ITERS     = 20;
+constexpr int LEVEL_WIDTH   = 16384;
+constexpr int LEVEL_HEIGHT  = 16384;
+
+
+//---------------------------------------------------------
+// Desc:   create an entity with transform and collider at random position
+//---------------------------------------------------------
+Collider& AddColliderEntt(
+    std::mt19937& rng,
+    const char* name,
+    const eColliderTag tag,
+    const eLayerType layer)
+{
+    Entity& entt = g_EntityMgr.AddEntity(name, layer);
+
+    const int x = rng() % LEVEL_WIDTH;
+    const int y = rng() % LEVEL_HEIGHT;
+
+    entt.AddComponent<Transform>(x, y, 0, 0, 32, 32, 2);
+    Collider& collider = entt.AddComponent<Collider>(tag, x, y, 32, 32);
+    collider.UpdateColliderRect();
+
+    return collider;
+}
+
+//---------------------------------------------------------
+// Desc:   run collision tests several times and return avg time in ms
+// Out:    - outEvents: events generated by the last run
+//---------------------------------------------------------
+double RunCollisions(std::vector<CollisionEvent>& outEvents)
+{
+    double sumMs = 0;
+
+    for (int i = 0; i < NUM_ITERS; ++i)
+    {
+        g_EventMgr.Clear();
+
+        const auto start = std::chrono::high_resolution_clock::now();
+        g_EntityMgr.CheckCollisions();
+        const auto end   = std::chrono::high_resolution_clock::now();
+
+        sumMs += std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+    s_Events.clear();
+    g_EventMgr.Dispatch();
+    outEvents = s_Events;
+
+    return sumMs / NUM_ITERS;
+}
+
+//---------------------------------------------------------
+// Desc:   check if two sequences of events are the same
+//---------------------------------------------------------
+bool IsSameEvents(
+    const std::vector<CollisionEvent>& a,
+    const std::vector<CollisionEvent>& b)
+{
+    if (a.size() != b.size())
+        return false;
+
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        if (a[i].type != b[i].type || a[i].id != b[i].id)
+            return false;
+    }
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////
+
+int main()
+{
+    std::mt19937 rng(12345);
+
+    g_GameStates.levelMapWidth  = LEVEL_WIDTH;
+    g_GameStates.levelMapHeight = LEVEL_HEIGHT;
+
+    // create a scene: enemies + projectiles (dynamic), vegetation (static)
+    const eColliderTag dynamicTags[3] = { ENEMY, PROJECTILE, FRIENDLY_PROJECTILE };
+
+    AddColliderEntt(rng, "player", PLAYER, LAYER_PLAYER);
+
+    for (int i = 0; i < NUM_DYNAMIC; ++i)
+        AddColliderEntt(rng, "dynamic", dynamicTags[i % 3], LAYER_ENEMY);
+
+    for (int i = 0; i < NUM_STATIC; ++i)
+        AddColliderEntt(rng, "static", ENEMY, LAYER_VEGETATION).MarkStatic();
+
+    g_EntityMgr.BuildStaticColliders();
+
+    g_EventMgr.Subscribe<EventPlayerHitEnemyProjectile>(RecordEvent, nullptr);
+    g_EventMgr.Subscribe<EventDestroyEntity>(RecordEvent, nullptr);
+    g_EventMgr.Subscribe<EventKillEnemy>(RecordEvent, nullptr);
+
+    // serial path
+    std::vector<CollisionEvent> serialEvents;
+    g_EntityMgr.SetParallelCollisions(false);
+    const double serialMs = RunCollisions(serialEvents);
+
+    printf("\ncolliders: %d dynamic, %d static\n", NUM_DYNAMIC + 1, NUM_STATIC);
+    printf("serial:               %8.3f ms (events: %d)\n", serialMs, (int)serialEvents.size());
+
+    // parallel path by number of threads (workers + the main thread)
+    g_EntityMgr.SetParallelCollisions(true);
+
+    const int maxThreads = (int)std::thread::hardware_concurrency();
+    bool      isSame     = true;
+
+    for (int numThreads = 1; numThreads <= maxThreads; numThreads *= 2)
+    {
+        g_JobSystem.Initialize(numThreads - 1);
+
+        std::vector<CollisionEvent> events;
+        const double ms = RunCollisions(events);
+        const bool same = IsSameEvents(serialEvents, events);
+
+        printf("parallel (%2d threads): %8.3f ms  speedup: %5.2fx  same result: %s\n",
+            numThreads, ms, serialMs / ms, same ? "yes" : "NO");
+
+        isSame &= same;
+    }
+
+    g_JobSystem.Shutdown();
+    return isSame ? 0 : 1;
+}
@@ -0,0 +1,187 @@
+// ==================================================================
+// Filename:    EventQueueStress.cpp
+// Description: a stress test of the lock-free MPSC queue of posted events
+//              (is built with -fsanitize=thread, see `make stress_events`):
+//              - streaming: several producers push while the consumer pops
+//                (a producer retries when the queue is full); items of each
+//                producer must come out exactly in order of pushing, none lost
+//              - overflow: producers push into the queue with no consumer;
+//                exactly CAPACITY items get in, the rest is counted as dropped
+//
+// Created:     19.10.2026 by DimaSkup
+// ==================================================================
+#include "../src/MPSCQueue.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <stdio.h>
+
+constexpr int NUM_PRODUCERS      = 4;
+constexpr int ITEMS_PER_PRODUCER = 200000;
+constexpr int QUEUE_CAPACITY     = 1024;
+constexpr int NUM_ROUNDS         = 10;      // of the overflow test
+
+struct StressItem
+{
+    uint32_t producer;
+    uint32_t seq;           // a sequence number of the item by its producer
+};
+
+using StressQueue = MPSCQueue<StressItem, QUEUE_CAPACITY>;
+
+
+//---------------------------------------------------------
+// Desc:   producers push items while the consumer pops them
+// Ret:    false if the order of items is broken or any item is lost
+//---------------------------------------------------------
+bool TestStreaming()
+{
+    StressQueue* pQueue = new StressQueue();
+
+    std::atomic<int>         numFull{0};         // failed pushes (were retried)
+    std::atomic<int>         numActive{NUM_PRODUCERS};
+    std::vector<std::thread> producers;
+
+    for (uint32_t p = 0; p < NUM_PRODUCERS; ++p)
+    {
+        producers.emplace_back([pQueue, p, &numFull, &numActive]()
+        {
+            for (uint32_t i = 0; i < ITEMS_PER_PRODUCER; ++i)
+            {
+                while (!pQueue->Push({ p, i }))
+                {
+                    numFull.fetch_add(1, std::memory_order_relaxed);
+                    std::this_thread::yield();
+                }
+            }
+
+            numActive.fetch_sub(1, std::memory_order_release);
+        });
+    }
+
+    // the consumer: the last popped seq of each producer
+    int64_t    lastSeq[NUM_PRODUCERS];
+    int        numPopped   = 0;
+    int        numBadOrder = 0;
+    StressItem item;
+
+    for (int64_t& seq : lastSeq)
+        seq = -1;
+
+    while (true)
+    {
+        const bool isDone = (numActive.load(std::memory_order_acquire) == 0);
+
+        while (pQueue->Pop(item))
+        {
+            // nothing is dropped so the seq goes exactly one by one
+            if ((int64_t)item.seq != lastSeq[item.producer] + 1)
+                numBadOrder++;
+
+            lastSeq[item.producer] = item.seq;
+            numPopped++;
+        }
+
+        // all the producers finished before the last draining
+        if (isDone)
+            break;
+
+        std::this_thread::yield();
+    }
+
+    for (std::thread& t : producers)
+        t.join();
+
+    const int  numPushed = NUM_PRODUCERS * ITEMS_PER_PRODUCER;
+    const bool isOk      = (numBadOrder == 0) && (numPopped == numPushed);
+
+    printf("streaming: producers: %d, pushed: %d, popped: %d, full queue retries: %d, bad order: %d -- %s\n",
+        NUM_PRODUCERS, numPushed, numPopped, numFull.load(), numBadOrder, isOk ? "ok" : "FAILED");
+
+    delete pQueue;
+    return isOk;
+}
+
+//---------------------------------------------------------
+// Desc:   producers fill the queue with no consumer, then it's drained
+// Ret:    false if the number of items/dropped is wrong or the order is broken
+//---------------------------------------------------------
+bool TestOverflow()
+{
+    bool isOk = true;
+
+    for (int round = 0; round < NUM_ROUNDS; ++round)
+    {
+        StressQueue* pQueue = new StressQueue();
+
+        // each producer pushes more than the whole capacity
+        const uint32_t itemsPerProducer = QUEUE_CAPACITY / 2 + 1;
+
+        std::atomic<int>         numDropped{0};
+        std::vector<std::thread> producers;
+
+        for (uint32_t p = 0; p < NUM_PRODUCERS; ++p)
+        {
+            producers.emplace_back([pQueue, p, itemsPerProducer, &numDropped]()
+            {
+                for (uint32_t i = 0; i < itemsPerProducer; ++i)
+                {
+                    if (!pQueue->Push({ p, i }))
+                        numDropped.fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+        }
+
+        for (std::thread& t : producers)
+            t.join();
+
+        int64_t    lastSeq[NUM_PRODUCERS];
+        int        numPopped   = 0;
+        int        numBadOrder = 0;
+        StressItem item;
+
+        for (int64_t& seq : lastSeq)
+            seq = -1;
+
+        while (pQueue->Pop(item))
+        {
+            if ((int64_t)item.seq <= lastSeq[item.producer])
+                numBadOrder++;
+
+            lastSeq[item.producer] = item.seq;
+            numPopped++;
+        }
+
+        const int  numPushed = NUM_PRODUCERS * itemsPerProducer;
+        const int  dropped   = numDropped.load();
+        const bool isRoundOk =
+            (numPopped == QUEUE_CAPACITY) &&
+            (dropped == numPushed - QUEUE_CAPACITY) &&
+            (numBadOrder == 0);
+
+        if (!isRoundOk)
+        {
+            printf("overflow round %d: pushed: %d, popped: %d, overflow: %d, bad order: %d -- FAILED\n",
+                round, numPushed, numPopped, dropped, numBadOrder);
+        }
+
+        isOk &= isRoundOk;
+        delete pQueue;
+    }
+
+    printf("overflow: %d rounds, capacity: %d -- %s\n", NUM_ROUNDS, QUEUE_CAPACITY, isOk ? "ok" : "FAILED");
+    return isOk;
+}
+
+///////////////////////////////////////////////////////////
+
+int main()
+{
+    printf("\nMPSC queue stress test\n");
+
+    bool isOk = true;
+    isOk &= TestStreaming();
+    isOk &= TestOverflow();
+
+    return isOk ? 0 : 1;
+}
@@ -0,0 +1,184 @@
+// ==================================================================
+// Filename:    JobBench.cpp
+// Description: a benchmark of the job system by number of threads:
+//              - scheduling overhead: time per empty job
+//                (submit + execute + wait)
+//              - nested jobs: jobs which submit and wait their own jobs
+//              - scaling efficiency of ParallelFor on a compute-bound loop
+//                (speedup / number of threads)
+//              also checks that the results are the same as the serial ones
+//
+// Created:     19.10.2026 by DimaSkup
+// ==================================================================
+#include "../src/JobSystem.h"
+#include <chrono>
+#include <vector>
+#include <stdio.h>
+#include <math.h>
+
+constexpr int NUM_EMPTY_JOBS   = 256 * 1024;
+constexpr int JOBS_PER_BATCH   = 1024;        // jobs in flight (less than the job pool)
+constexpr int NUM_OUTER_JOBS   = 256;
+constexpr int NUM_INNER_JOBS   = 64;
+constexpr int NUM_ITEMS        = 1 << 20;
+constexpr int ITEM_WORK        = 16;          // iterations of math per item
+constexpr int CHUNK_SIZE       = 1024;
+constexpr int NUM_RUNS         = 5;
+
+using Clock = std::chrono::high_resolution_clock;
+
+//---------------------------------------------------------
+// Desc:   get milliseconds since the input time point
+//---------------------------------------------------------
+double MsSince(const Clock::time_point& start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+//---------------------------------------------------------
+// Desc:   submit empty jobs by batches and wait for each batch
+// Ret:    nanoseconds per job
+//---------------------------------------------------------
+double BenchEmptyJobs(int& outNumExecuted)
+{
+    std::atomic<int> numExecuted{0};
+    const auto       start = Clock::now();
+
+    for (int i = 0; i < NUM_EMPTY_JOBS; i += JOBS_PER_BATCH)
+    {
+        JobCounter counter;
+
+        for (int j = 0; j < JOBS_PER_BATCH; ++j)
+        {
+            std::atomic<int>* pNumExecuted = &numExecuted;
+            g_JobSystem.Submit(counter, [pNumExecuted]() { pNumExecuted->fetch_add(1, std::memory_order_relaxed); });
+        }
+
+        g_JobSystem.Wait(counter);
+    }
+
+    const double ms = MsSince(start);
+    outNumExecuted = numExecuted.load();
+
+    return ms * 1e6 / outNumExecuted;
+}
+
+//---------------------------------------------------------
+// Desc:   jobs which submit their own jobs and wait them (dependencies)
+// Ret:    milliseconds
+//---------------------------------------------------------
+double BenchNestedJobs(int& outNumExecuted)
+{
+    std::atomic<int> numExecuted{0};
+    std::atomic<int>* pNumExecuted = &numExecuted;
+    JobCounter       counter;
+    const auto       start = Clock::now();
+
+    for (int i = 0; i < NUM_OUTER_JOBS; ++i)
+    {
+        g_JobSystem.Submit(counter, [pNumExecuted]()
+        {
+            JobCounter innerCounter;
+
+            for (int j = 0; j < NUM_INNER_JOBS; ++j)
+                g_JobSystem.Submit(innerCounter, [pNumExecuted]() { pNumExecuted->fetch_add(1, std::memory_order_relaxed); });
+
+            g_JobSystem.Wait(innerCounter);
+        });
+    }
+
+    g_JobSystem.Wait(counter);
+
+    const double ms = MsSince(start);
+    outNumExecuted = numExecuted.load();
+
+    return ms;
+}
+
+//---------------------------------------------------------
+// Desc:   some compute-bound work per item
+//---------------------------------------------------------
+inline float ItemWork(const int i)
+{
+    float x = (float)i * 0.001f;
+
+    for (int k = 0; k < ITEM_WORK; ++k)
+        x = sinf(x) * 0.5f + x * 0.75f + 0.1f;
+
+    return x;
+}
+
+//---------------------------------------------------------
+// Desc:   compute all the items by ParallelFor (the best of a few runs)
+// Ret:    milliseconds
+//---------------------------------------------------------
+double BenchParallelFor(std::vector<float>& outItems)
+{
+    double bestMs = 1e30;
+
+    for (int run = 0; run < NUM_RUNS; ++run)
+    {
+        const auto start = Clock::now();
+
+        g_JobSystem.ParallelFor(NUM_ITEMS, CHUNK_SIZE,
+            [&outItems](const int chunkIdx, const int begin, const int end)
+            {
+                for (int i = begin; i < end; ++i)
+                    outItems[i] = ItemWork(i);
+            });
+
+        const double ms = MsSince(start);
+        bestMs = (ms < bestMs) ? ms : bestMs;
+    }
+
+    return bestMs;
+}
+
+///////////////////////////////////////////////////////////
+
+int main()
+{
+    // serial result for checking
+    std::vector<float> serialItems(NUM_ITEMS);
+
+    const auto serialStart = Clock::now();
+    for (int i = 0; i < NUM_ITEMS; ++i)
+        serialItems[i] = ItemWork(i);
+    const double serialMs = MsSince(serialStart);
+
+    printf("\nparallel for: %d items, %d per chunk; serial loop: %.3f ms\n", NUM_ITEMS, CHUNK_SIZE, serialMs);
+    printf("threads | empty job, ns | nested jobs, ms | parallel for, ms | speedup | efficiency | same result\n");
+
+    const int maxThreads = (int)std::thread::hardware_concurrency();
+    double    oneThreadMs = 0;
+    bool      isSame = true;
+
+    for (int numThreads = 1; numThreads <= maxThreads; numThreads *= 2)
+    {
+        g_JobSystem.Initialize(numThreads - 1);
+
+        int numEmpty  = 0;
+        int numNested = 0;
+        std::vector<float> items(NUM_ITEMS, 0);
+
+        const double emptyNs  = BenchEmptyJobs(numEmpty);
+        const double nestedMs = BenchNestedJobs(numNested);
+        const double forMs    = BenchParallelFor(items);
+
+        if (numThreads == 1)
+            oneThreadMs = forMs;
+
+        const double speedup = oneThreadMs / forMs;
+        const bool   same    = (items == serialItems) &&
+                               (numEmpty == NUM_EMPTY_JOBS) &&
+                               (numNested == NUM_OUTER_JOBS * NUM_INNER_JOBS);
+
+        printf("%7d | %13.1f | %15.3f | %16.3f | %6.2fx | %9.0f%% | %s\n",
+            numThreads, emptyNs, nestedMs, forMs, speedup, 100.0 * speedup / numThreads, same ? "yes" : "NO");
+
+        isSame &= same;
+    }
+
+    g_JobSystem.Shutdown();
+    return isSame ? 0 : 1;
+}
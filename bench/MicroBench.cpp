@@ -0,0 +1,405 @@
+// ==================================================================
+// Filename:    MicroBench.cpp
+// Description: microbenchmarks of the engine's hot paths in isolation:
+//              entity manager, components lookup, collision test,
+//              events, assets lookup and map loading;
+//
+//              each benchmark is repeated several times and the median
+//              (and min) time per operation is reported; the results are
+//              written into a JSON file so they can be diffed between commits
+//
+//              usage: ./micro_bench [output.json]
+//
+// Created:     19.10.2026 by DimaSkup
+// ==================================================================
+#include "../src/EntityMgr.h"
+#include "../src/EventMgr.h"
+#include "../src/AssetMgr.h"
+#include "../src/Render.h"
+#include "../src/Map.h"
+#include "../src/GameState.h"
+#include "../src/Collision.h"
+#include "../src/Components/Transform.h"
+#include "../src/Components/Collider.h"
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include <stdio.h>
+
+GameStates g_GameStates;
+
+constexpr int NUM_RUNS = 7;               // each benchmark is repeated (the median is reported)
+
+struct BenchResult
+{
+    std::string name;
+    int         opsPerRun   = 0;
+    double      medianNsOp  = 0;
+    double      minNsOp     = 0;
+};
+
+std::vector<BenchResult> s_Results;
+
+// results of the measured code are accumulated here so it isn't optimized out
+volatile uint64_t s_Sink = 0;
+
+using Clock = std::chrono::high_resolution_clock;
+
+
+//---------------------------------------------------------
+// Desc:   run a benchmark NUM_RUNS times and store ns per operation
+// Args:   - name:       a name of the benchmark (a key in JSON)
+//         - opsPerRun:  how many operations the body makes per run
+//         - setup:      is called before each run (isn't measured)
+//         - body:       the measured code
+//         - teardown:   is called after each run (isn't measured)
+//---------------------------------------------------------
+template <typename Setup, typename Body, typename Teardown>
+void RunBench(
+    const char* name,
+    const int opsPerRun,
+    Setup setup,
+    Body body,
+    Teardown teardown)
+{
+    std::vector<double> nsPerOp;
+
+    for (int run = 0; run < NUM_RUNS; ++run)
+    {
+        setup();
+
+        const auto start = Clock::now();
+        body();
+        const auto end   = Clock::now();
+
+        teardown();
+
+        const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+        nsPerOp.push_back(ns / opsPerRun);
+    }
+
+    std::sort(nsPerOp.begin(), nsPerOp.end());
+
+    BenchResult result;
+    result.name       = name;
+    result.opsPerRun  = opsPerRun;
+    result.medianNsOp = nsPerOp[NUM_RUNS / 2];
+    result.minNsOp    = nsPerOp[0];
+
+    s_Results.push_back(result);
+}
+
+template <typename Body>
+void RunBench(const char* name, const int opsPerRun, Body body)
+{
+    RunBench(name, opsPerRun, []{}, body, []{});
+}
+
+//---------------------------------------------------------
+// Desc:   remove all the entities; destroying of entity queues
+//         an event so the events are dropped as well
+//---------------------------------------------------------
+void ClearScene()
+{
+    g_EntityMgr.ClearData();
+    g_EventMgr.Clear();
+}
+
+//---------------------------------------------------------
+// Desc:   create entities with transform and collider
+//---------------------------------------------------------
+void AddEntities(const std::vector<std::string>& names, std::vector<EntityID>& outIDs)
+{
+    outIDs.clear();
+
+    for (const std::string& name : names)
+    {
+        Entity& entt = g_EntityMgr.AddEntity(name.c_str(), LAYER_ENEMY);
+        entt.AddComponent<Transform>(0, 0, 0, 0, 32, 32, 1);
+        entt.AddComponent<Collider>(ENEMY, 0, 0, 32, 32);
+
+        outIDs.push_back(entt.GetID());
+    }
+}
+
+//---------------------------------------------------------
+// Desc:   write a .map file of random tile codes for Map::LoadMap
+//---------------------------------------------------------
+bool WriteMapFile(const char* filename, const int sizeX, const int sizeY, std::mt19937& rng)
+{
+    FILE* pFile = fopen(filename, "w");
+    if (!pFile)
+        return false;
+
+    for (int y = 0; y < sizeY; ++y)
+    {
+        for (int x = 0; x < sizeX; ++x)
+        {
+            // separate statements: the order of evaluation of args isn't defined
+            const int row = (int)(rng() % 3);
+            const int col = (int)(rng() % 10);
+
+            fprintf(pFile, "%d%d%s", row, col, (x < sizeX-1) ? "," : "");
+        }
+
+        fprintf(pFile, "\n");
+    }
+
+    fclose(pFile);
+    return true;
+}
+
+//---------------------------------------------------------
+// Desc:   print results as a table and write them into JSON file
+//---------------------------------------------------------
+bool WriteResults(const char* filename)
+{
+    printf("\n%-32s %12s %14s %14s\n", "benchmark", "ops/run", "median ns/op", "min ns/op");
+
+    for (const BenchResult& r : s_Results)
+        printf("%-32s %12d %14.2f %14.2f\n", r.name.c_str(), r.opsPerRun, r.medianNsOp, r.minNsOp);
+
+    FILE* pFile = fopen(filename, "w");
+    if (!pFile)
+    {
+        printf("can't open a file for results: %s\n", filename);
+        return false;
+    }
+
+    fprintf(pFile, "{\n  \"runs\": %d,\n  \"benchmarks\": [\n", NUM_RUNS);
+
+    for (size_t i = 0; i < s_Results.size(); ++i)
+    {
+        const BenchResult& r = s_Results[i];
+
+        fprintf(pFile, "    {\"name\": \"%s\", \"ops_per_run\": %d, \"median_ns_per_op\": %.3f, \"min_ns_per_op\": %.3f}%s\n",
+            r.name.c_str(), r.opsPerRun, r.medianNsOp, r.minNsOp,
+            (i < s_Results.size()-1) ? "," : "");
+    }
+
+    fprintf(pFile, "  ]\n}\n");
+    fclose(pFile);
+
+    printf("\nresults are written: %s\n", filename);
+    return true;
+}
+
+///////////////////////////////////////////////////////////
+
+int main(int argc, char* argv[])
+{
+    const char* outFilename = (argc > 1) ? argv[1] : "bench_results.json";
+
+    std::mt19937 rng(12345);
+
+    constexpr int NUM_ENTTS   = 10000;
+    constexpr int NUM_LOOKUPS = 100000;
+
+    std::vector<std::string> names;
+    std::vector<EntityID>    ids;
+
+    for (int i = 0; i < NUM_ENTTS; ++i)
+        names.push_back("entt_" + std::to_string(i));
+
+    // ---------------------------------------------------------------
+    // entity manager
+    // ---------------------------------------------------------------
+    RunBench("EntityMgr::AddEntity", NUM_ENTTS,
+        [] {},
+        [&] {
+            for (const std::string& name : names)
+                s_Sink += g_EntityMgr.AddEntity(name.c_str(), LAYER_ENEMY).GetID();
+        },
+        [] { ClearScene(); });
+
+    // destroying is O(num of entities) so it is measured on a smaller set
+    constexpr int NUM_DESTROY = 2000;
+    std::vector<std::string> destroyNames(names.begin(), names.begin() + NUM_DESTROY);
+
+    RunBench("EntityMgr::DestroyEntt", NUM_DESTROY,
+        [&] {
+            AddEntities(destroyNames, ids);
+            std::shuffle(ids.begin(), ids.end(), rng);
+        },
+        [&] {
+            for (const EntityID id : ids)
+                g_EntityMgr.DestroyEntt(id);
+        },
+        [] { ClearScene(); });
+
+    // lookups are made in random order over the whole set
+    AddEntities(names, ids);
+
+    std::vector<EntityID>    lookupIDs(NUM_LOOKUPS);
+    std::vector<const char*> lookupNames(NUM_LOOKUPS);
+
+    for (int i = 0; i < NUM_LOOKUPS; ++i)
+    {
+        const int idx  = rng() % NUM_ENTTS;
+        lookupIDs[i]   = ids[idx];
+        lookupNames[i] = names[idx].c_str();
+    }
+
+    RunBench("EntityMgr::GetEnttByID", NUM_LOOKUPS, [&] {
+        for (const EntityID id : lookupIDs)
+            s_Sink += (uintptr_t)g_EntityMgr.GetEnttByID(id);
+    });
+
+    RunBench("EntityMgr::GetEnttByName", NUM_LOOKUPS, [&] {
+        for (const char* name : lookupNames)
+            s_Sink += (uintptr_t)g_EntityMgr.GetEnttByName(name);
+    });
+
+    // ---------------------------------------------------------------
+    // components
+    // ---------------------------------------------------------------
+    std::vector<Entity*> lookupEntts(NUM_LOOKUPS);
+
+    for (int i = 0; i < NUM_LOOKUPS; ++i)
+        lookupEntts[i] = g_EntityMgr.GetEnttByID(lookupIDs[i]);
+
+    RunBench("Entity::GetComponent<Transform>", NUM_LOOKUPS, [&] {
+        for (Entity* pEntt : lookupEntts)
+            s_Sink += (uintptr_t)pEntt->GetComponent<Transform>();
+    });
+
+    RunBench("Entity::GetComponent<Collider>", NUM_LOOKUPS, [&] {
+        for (Entity* pEntt : lookupEntts)
+            s_Sink += (uintptr_t)pEntt->GetComponent<Collider>();
+    });
+
+    ClearScene();
+
+    // ---------------------------------------------------------------
+    // collision test
+    // ---------------------------------------------------------------
+    constexpr int NUM_RECTS = 1 << 12;
+    constexpr int NUM_TESTS = 1000000;
+    std::vector<SDL_Rect> rects(NUM_RECTS);
+
+    for (SDL_Rect& r : rects)
+        r = { (int)(rng() % 2048), (int)(rng() % 2048), 16 + (int)(rng() % 64), 16 + (int)(rng() % 64) };
+
+    RunBench("Collision::CheckRectCollision", NUM_TESTS, [&] {
+        uint64_t numHits = 0;
+
+        for (int i = 0; i < NUM_TESTS; ++i)
+            numHits += Collision::CheckRectCollision(rects[i & (NUM_RECTS-1)], rects[(i * 7 + 1) & (NUM_RECTS-1)]);
+
+        s_Sink += numHits;
+    });
+
+    // ---------------------------------------------------------------
+    // events: enqueue (with/without coalescing), post from a thread, dispatch
+    // ---------------------------------------------------------------
+    static uint64_t s_NumHandled = 0;
+    g_EventMgr.Subscribe<EventDestroyEntity>([](void*, const EventDestroyEntity& e) { s_NumHandled += e.id; }, nullptr);
+    g_EventMgr.Subscribe<EventPlayerMove>   ([](void*, const EventPlayerMove& e)    { s_NumHandled += e.id; }, nullptr);
+
+    constexpr int NUM_EVENTS = EVENT_QUEUE_CAPACITY;
+
+    RunBench("EventMgr::AddEvent", NUM_EVENTS,
+        [] {},
+        [] {
+            for (int i = 0; i < NUM_EVENTS; ++i)
+                g_EventMgr.AddEvent(EventDestroyEntity(i));
+        },
+        [] { g_EventMgr.Clear(); });
+
+    g_EventMgr.SetCoalescing<EventPlayerMove>(COALESCE_LAST_WRITER_WINS);
+
+    RunBench("EventMgr::AddEvent (coalesced)", NUM_EVENTS,
+        [] {},
+        [] {
+            for (int i = 0; i < NUM_EVENTS; ++i)
+                g_EventMgr.AddEvent(EventPlayerMove(i & 255, 1.0f, 0.0f));
+        },
+        [] { g_EventMgr.Clear(); });
+
+    RunBench("EventMgr::PostEvent", NUM_EVENTS,
+        [] {},
+        [] {
+            for (int i = 0; i < NUM_EVENTS; ++i)
+                g_EventMgr.PostEvent(EventDestroyEntity(i), MakeEventOrderKey(0, NUM_EVENTS - i));
+        },
+        [] { g_EventMgr.Clear(); });
+
+    RunBench("EventMgr::DrainPosted+Dispatch", NUM_EVENTS,
+        [] {
+            for (int i = 0; i < NUM_EVENTS; ++i)
+                g_EventMgr.PostEvent(EventDestroyEntity(i), MakeEventOrderKey(0, NUM_EVENTS - i));
+        },
+        [] { g_EventMgr.Dispatch(); },
+        [] { g_EventMgr.Clear(); });
+
+    RunBench("EventMgr::Dispatch", NUM_EVENTS,
+        [] {
+            for (int i = 0; i < NUM_EVENTS; ++i)
+                g_EventMgr.AddEvent(EventDestroyEntity(i));
+        },
+        [] { g_EventMgr.Dispatch(); },
+        [] { g_EventMgr.Clear(); });
+
+    s_Sink += s_NumHandled;
+
+    // ---------------------------------------------------------------
+    // assets and map: textures require a renderer so SDL is initialized
+    // headless (the dummy video driver)
+    // ---------------------------------------------------------------
+    Render render;
+
+    if (render.Initialize(64, 64, false, true))
+    {
+        const char* textureIDs[] =
+        {
+            "chopper-texture", "projectile-texture", "obstacles-texture", "truck-left-texture",
+            "tank-big-down-texture", "rock-big-1-texture", "tree-small-1-texture", "radar-texture",
+        };
+        const char* texturePaths[] =
+        {
+            "./assets/images/chopper-spritesheet.png", "./assets/images/bullet-enemy.png",
+            "./assets/images/obstacles.png",           "./assets/images/truck-left.png",
+            "./assets/images/tank-big-down.png",       "./assets/images/rock-big-1.png",
+            "./assets/images/tree-small-1.png",        "./assets/images/radar.png",
+        };
+        constexpr int numTextures = sizeof(textureIDs) / sizeof(textureIDs[0]);
+
+        for (int i = 0; i < numTextures; ++i)
+            g_AssetMgr.AddTexture(textureIDs[i], texturePaths[i]);
+
+        RunBench("AssetMgr::GetTexture", NUM_LOOKUPS, [&] {
+            for (int i = 0; i < NUM_LOOKUPS; ++i)
+                s_Sink += (uintptr_t)g_AssetMgr.GetTexture(textureIDs[i % numTextures]);
+        });
+
+        // (tiles destroy their texture so the map uses a texture which isn't loaded)
+        constexpr int MAP_SIZE = 100;
+        const char*   mapFile  = "micro_bench.map";
+
+        if (WriteMapFile(mapFile, MAP_SIZE, MAP_SIZE, rng))
+        {
+            Map* pMap = nullptr;
+
+            RunBench("Map::LoadMap (100x100)", MAP_SIZE * MAP_SIZE,
+                [&] { pMap = new Map("micro-bench-map-texture", 4, 32); },
+                [&] { pMap->LoadMap(mapFile, MAP_SIZE, MAP_SIZE); },
+                [&] {
+                    delete pMap;
+                    ClearScene();
+                });
+
+            remove(mapFile);
+        }
+
+        g_AssetMgr.ClearData();
+        render.Shutdown();
+    }
+    else
+    {
+        printf("can't initialize SDL: AssetMgr and Map benchmarks are skipped\n");
+    }
+
+    return WriteResults(outFilename) ? 0 : 1;
+}
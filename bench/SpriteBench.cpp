@@ -0,0 +1,174 @@
+// ==================================================================
+// Filename:    SpriteBench.cpp
+// Description: a benchmark of the update of moving sprites (Transform +
+//              Sprite) by number of entities (10k..100k):
+//              - serial: each entity updates its components by virtual calls
+//              - systems: chunked parallel update by the systems scheduler
+//                (vectorized integration of positions) by number of threads
+//              also checks that the result is the same as the serial one
+//
+// Created:     19.10.2026 by DimaSkup
+// ==================================================================
+#include "../src/EntityMgr.h"
+#include "../src/JobSystem.h"
+#include "../src/GameState.h"
+#include "../src/Log.h"
+#include "../src/Components/Transform.h"
+#include "../src/Components/Sprite.h"
+#include <chrono>
+#include <random>
+#include <vector>
+#include <stdio.h>
+#include <string.h>
+
+GameStates g_GameStates;
+
+constexpr int   NUM_FRAMES    = 30;
+constexpr int   LEVEL_WIDTH   = 8192;
+constexpr int   LEVEL_HEIGHT  = 8192;
+constexpr float DELTA_TIME    = 1.0f / 60.0f;
+constexpr int   NUM_ENTTS[]   = { 10000, 30000, 100000 };
+
+// a state of the sprite after the update
+struct SpriteState
+{
+    float    posX;
+    float    posY;
+    SDL_Rect srcRect;
+    SDL_Rect dstRect;
+};
+
+using Clock = std::chrono::high_resolution_clock;
+
+
+//---------------------------------------------------------
+// Desc:   create moving sprites at random positions (the same for each seed);
+//         some of them are fast so they hit the level's borders
+//---------------------------------------------------------
+void CreateScene(const int numEntts)
+{
+    std::mt19937 rng(12345);
+
+    g_EntityMgr.ClearData();
+    g_EventMgr.Clear();        // destroy events of the previous scene
+
+    // sprites compute their rects when they are added so each run starts with the same camera
+    g_GameStates.cameraPosX = 0;
+    g_GameStates.cameraPosY = 0;
+
+    for (int i = 0; i < numEntts; ++i)
+    {
+        Entity& entt = g_EntityMgr.AddEntity("sprite", LAYER_ENEMY);
+
+        TransformInitParams trParams;
+        trParams.pos    = { (float)(rng() % LEVEL_WIDTH), (float)(rng() % LEVEL_HEIGHT) };
+        trParams.vel    = { (float)((int)(rng() % 2001) - 1000), (float)((int)(rng() % 2001) - 1000) };
+        trParams.width  = 32;
+        trParams.height = 32;
+        trParams.scale  = 1 + (i & 1);
+
+        SpriteInitParams spriteParams;
+        spriteParams.numFrames      = 1 + (rng() % 8);
+        spriteParams.animationSpeed = 50 + (rng() % 100);
+        spriteParams.hasDirections  = (i % 3 == 0);
+        spriteParams.isFixed        = false;
+
+        entt.AddComponent<Transform>(trParams);
+        entt.AddComponent<Sprite>("sprite-texture", spriteParams);
+    }
+}
+
+//---------------------------------------------------------
+// Desc:   update the scene NUM_FRAMES times (the camera moves each frame)
+// Out:    - outStates: sprites states after the last frame
+// Ret:    milliseconds per frame
+//---------------------------------------------------------
+double RunFrames(const int numEntts, std::vector<SpriteState>& outStates)
+{
+    CreateScene(numEntts);
+
+    const auto start = Clock::now();
+
+    for (int i = 0; i < NUM_FRAMES; ++i)
+    {
+        g_GameStates.cameraPosX = i * 3;
+        g_GameStates.cameraPosY = i * 2;
+        g_EntityMgr.Update(DELTA_TIME);
+    }
+
+    const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    outStates.clear();
+
+    for (Entity* pEntt : g_EntityMgr.GetEntts())
+    {
+        const Transform* pTransform = pEntt->GetComponent<Transform>();
+        const Sprite*    pSprite    = pEntt->GetComponent<Sprite>();
+
+        outStates.push_back({
+            pTransform->m_Position.x,
+            pTransform->m_Position.y,
+            pSprite->GetSrcRect(),
+            pSprite->GetDstRect() });
+    }
+
+    return ms / NUM_FRAMES;
+}
+
+//---------------------------------------------------------
+// Desc:   check if two states are bitwise the same
+//---------------------------------------------------------
+bool IsSameStates(const std::vector<SpriteState>& a, const std::vector<SpriteState>& b)
+{
+    return (a.size() == b.size()) &&
+           (memcmp(a.data(), b.data(), a.size() * sizeof(SpriteState)) == 0);
+}
+
+///////////////////////////////////////////////////////////
+
+int main()
+{
+    // sprites have no textures here, and ClearData() posts a destroy
+    // event per entity which overflows the events queue: don't report it
+    SetLogCategoryLevel("Sprite",   LOG_LEVEL_NONE);
+    SetLogCategoryLevel("EventMgr", LOG_LEVEL_NONE);
+
+    g_GameStates.levelMapWidth  = LEVEL_WIDTH;
+    g_GameStates.levelMapHeight = LEVEL_HEIGHT;
+
+    const int maxThreads = (int)std::thread::hardware_concurrency();
+    bool      isSame     = true;
+
+    printf("\nmoving sprites update, %d frames\n", NUM_FRAMES);
+    printf("entities | serial, ms | threads | systems, ms | speedup | same result\n");
+
+    for (const int numEntts : NUM_ENTTS)
+    {
+        std::vector<SpriteState> serialStates;
+        std::vector<SpriteState> states;
+
+        g_JobSystem.Initialize(0);
+        g_EntityMgr.SetScheduledUpdate(false);
+        const double serialMs = RunFrames(numEntts, serialStates);
+
+        g_EntityMgr.SetScheduledUpdate(true);
+
+        for (int numThreads = 1; numThreads <= maxThreads; numThreads *= 2)
+        {
+            g_JobSystem.Initialize(numThreads - 1);
+
+            const double ms   = RunFrames(numEntts, states);
+            const bool   same = IsSameStates(states, serialStates);
+
+            printf("%8d | %10.3f | %7d | %11.3f | %6.2fx | %s\n",
+                numEntts, serialMs, numThreads, ms, serialMs / ms, same ? "yes" : "NO");
+
+            isSame &= same;
+        }
+    }
+
+    g_EntityMgr.ClearData();
+    g_JobSystem.Shutdown();
+
+    return isSame ? 0 : 1;
+}
@@ -0,0 +1,26 @@
+#!/bin/sh
+# ==================================================================
+# Filename:    stress_sweep.sh
+# Description: run the game headless on generated stress scenes with
+#              a growing number of enemies; results of each run
+#              (frame time and time per profiler zone) are written
+#              into stress_<N>.json
+#
+#              usage: ./bench/stress_sweep.sh [frames] [map size in tiles]
+#
+# Created:     19.10.2026 by DimaSkup
+# ==================================================================
+FRAMES=${1:-300}
+MAP_SIZE=${2:-200}
+
+for N in 1000 5000 10000 50000 100000
+do
+    OBSTACLES=$((N / 2))
+    echo "stress scene: enemies $N, obstacles $OBSTACLES, map ${MAP_SIZE}x${MAP_SIZE}"
+
+    ./game --headless --frames=$FRAMES \
+        --stress=$N,$OBSTACLES,${MAP_SIZE}x${MAP_SIZE} \
+        --bench-out=stress_$N.json > /dev/null || exit 1
+
+    cat stress_$N.json
+done
@@ -8,6 +8,7 @@
 #include "FontMgr.h"
 #include "Log.h"
 #include "StrHelper.h"
+#include "JobSystem.h"
 
 // init global instance of the AssetMgr
 AssetMgr g_AssetMgr;
@@ -38,6 +39,7 @@ void AssetMgr::ClearData()
         TTF_CloseFont(it.second);
 
     m_Textures.clear();
+    m_TextureIDs.clear();
     m_Fonts.clear();
 
 }
@@ -69,9 +71,65 @@ void AssetMgr::AddTexture(const char* textureID, const char* filePath)
     }
 
     m_Textures.emplace(textureID, pTex);
+    m_TextureIDs.emplace(textureID, (uint16_t)(m_TextureIDs.size() + 1));
     LogMsg(LOG, "added texture: %s", textureID);
 }
 
+//---------------------------------------------------------
+// Desc:   load a batch of textures: images are decoded in parallel
+//         by jobs, then textures are created on this (main) thread
+//---------------------------------------------------------
+void AssetMgr::AddTextures(const std::vector<TextureDesc>& textures)
+{
+    const int                 numTextures = (int)textures.size();
+    std::vector<SDL_Surface*> surfaces(numTextures, nullptr);
+    JobCounter                counter;
+
+    for (int i = 0; i < numTextures; ++i)
+    {
+        const TextureDesc& desc = textures[i];
+
+        if (IsStrEmpty(desc.id.c_str()) || IsStrEmpty(desc.filePath.c_str()))
+        {
+            LogErr(LOG, "texture ID or path is empty (texture idx: %d)", i);
+            continue;
+        }
+
+        SDL_Surface** ppSurface = &surfaces[i];
+        const char*   filePath  = desc.filePath.c_str();
+
+        g_JobSystem.Submit(counter, [ppSurface, filePath]()
+        {
+            *ppSurface = TextureMgr::LoadSurface(filePath);
+        });
+    }
+
+    g_JobSystem.Wait(counter);
+
+    for (int i = 0; i < numTextures; ++i)
+    {
+        const TextureDesc& desc = textures[i];
+
+        if (!surfaces[i])
+        {
+            if (!IsStrEmpty(desc.filePath.c_str()))
+                LogErr(LOG, "didn't manage to load texture: %s", desc.filePath.c_str());
+            continue;
+        }
+
+        SDL_Texture* pTex = TextureMgr::CreateTexture(surfaces[i]);
+        if (!pTex)
+        {
+            LogErr(LOG, "didn't manage to create texture: %s", desc.filePath.c_str());
+            continue;
+        }
+
+        m_Textures.emplace(desc.id, pTex);
+        m_TextureIDs.emplace(desc.id, (uint16_t)(m_TextureIDs.size() + 1));
+        LogMsg(LOG, "added texture: %s", desc.id.c_str());
+    }
+}
+
 ///////////////////////////////////////////////////////////
 
 void AssetMgr::AddFont(
@@ -129,6 +187,21 @@ SDL_Texture* AssetMgr::GetTexture(const char* textureID)
 
 ///////////////////////////////////////////////////////////
 
+uint16_t AssetMgr::GetTextureID(const char* textureID)
+{
+    // get a numeric ID of the texture for sort keys of draw commands
+    // (IDs are assigned in order of loading; 0 - there is no such texture)
+
+    if (IsStrEmpty(textureID))
+        return 0;
+
+    const auto it = m_TextureIDs.find(textureID);
+
+    return (it != m_TextureIDs.end()) ? it->second : 0;
+}
+
+///////////////////////////////////////////////////////////
+
 TTF_Font* AssetMgr::GetFont(const char* fontID)
 {
     // get a font by input ID
@@ -13,6 +13,15 @@
 #include <SDL2/SDL_ttf.h>
 #include <map>
 #include <string>
+#include <vector>
+#include <stdint.h>
+
+// an ID and a path of texture to load
+struct TextureDesc
+{
+    std::string id;
+    std::string filePath;
+};
 
 class AssetMgr
 {
@@ -24,10 +33,12 @@ public:
     void SetEntityMgr(EntityMgr* pEnttMgr);
     void ClearData();
 
-    void AddTexture(const char* textureID, const char* filePath);
+    void AddTexture (const char* textureID, const char* filePath);
+    void AddTextures(const std::vector<TextureDesc>& textures);
     void AddFont   (const char* fontID, const char* filePath, const int fontSize);
 
     SDL_Texture* GetTexture(const char* textureID);
+    uint16_t     GetTextureID(const char* textureID);
     TTF_Font*    GetFont   (const char* fontID);
 
     SDL_Point    GetTextureSize(SDL_Texture* pTexture);
@@ -68,6 +79,7 @@ public:
 private:
     EntityMgr*                          m_pEnttMgr = nullptr;
     std::map<std::string, SDL_Texture*> m_Textures;
+    std::map<std::string, uint16_t>     m_TextureIDs;   // IDs for sort keys of draw commands
     std::map<std::string, TTF_Font*>    m_Fonts;
 };
 
@@ -19,6 +19,8 @@
 class Collider : public IComponent
 {
 public:
+    static constexpr eComponentType TYPE = COMPONENT_COLLIDER;
+
     Collider(
         const eColliderTag colliderTag, 
         const int x,
@@ -52,15 +54,46 @@ public:
     ///////////////////////////////////////////////////////
    
     virtual void Update(const float deltaTime) override
+    {
+        // static colliders never move so their rect was computed only once;
+        // and there is nothing to sync with if the entity has no transform
+        if (m_IsStatic || !m_pTransform)
+            return;
+
+        UpdateColliderRect();
+
+        m_DstRect.x = m_ColliderRect.x - g_GameStates.cameraPosX;
+        m_DstRect.y = m_ColliderRect.y - g_GameStates.cameraPosY;
+    }
+
+    //-----------------------------------------------------
+    // Desc:  mark this collider as static (it never moves) so its rect
+    //        is computed right here and won't be updated each frame;
+    //        such colliders are put into the static colliders grid
+    //-----------------------------------------------------
+    void MarkStatic()
+    {
+        if (!m_pTransform)
+        {
+            LogErr(LOG, "can't mark collider as static because the entity (name: %s) doesn't have the Transform component", m_pOwner->m_Name);
+            return;
+        }
+
+        UpdateColliderRect();
+        m_IsStatic = true;
+    }
+
+    inline bool IsStatic() const { return m_IsStatic; }
+
+    ///////////////////////////////////////////////////////
+
+    void UpdateColliderRect()
     {
         Transform* pT = m_pTransform;
         m_ColliderRect.x = (int)pT->m_Position.x;
         m_ColliderRect.y = (int)pT->m_Position.y;
         m_ColliderRect.w = pT->m_Width * pT->m_Scale;
         m_ColliderRect.h = pT->m_Height * pT->m_Scale;
-
-        m_DstRect.x = m_ColliderRect.x - g_GameStates.cameraPosX;
-        m_DstRect.y = m_ColliderRect.y - g_GameStates.cameraPosY;
     }
 
     ///////////////////////////////////////////////////////
@@ -74,9 +107,9 @@ public:
     eColliderTag m_ColliderTag;
     SDL_Rect     m_ColliderRect;
     SDL_Rect     m_SrcRect;
-    SDL_Rect     m_DstRect;
+    SDL_Rect     m_DstRect;               // in screen space; NOTE: isn't updated for static colliders (keeps the one of Initialize)
     Transform*   m_pTransform = nullptr;
-
+    bool         m_IsStatic   = false;    // static colliders are tested only via the grid
 };
 
 #endif
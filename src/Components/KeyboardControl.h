@@ -13,14 +13,22 @@
 #include "../StrHelper.h"
 #include "../IComponent.h"
 #include "../EventMgr.h"
+#include "../InputMgr.h"
 #include "../../lib/glm/glm.hpp"
 
 
 class KeyboardControl : public IComponent
 {
 public:
+    static constexpr eComponentType TYPE = COMPONENT_KEYBOARD_CONTROL;
+
     KeyboardControl();
 
+    //-----------------------------------------------------
+    // Desc:  compile key bindings (names from Lua, for instance: "w", "space")
+    //        into the action map of the input manager; arrows/space are
+    //        bound to these actions by default
+    //-----------------------------------------------------
     KeyboardControl(
         const char* upKey,
         const char* rightKey,
@@ -28,20 +36,11 @@ public:
         const char* leftKey,
         const char* shootKey)
     {
-        if (upKey && strcmp(upKey, "up") == 0)
-            m_UpKey = SDL_GetKeyFromName(upKey);
-        
-        if (rightKey && strcmp(rightKey, "right") == 0)
-            m_RightKey = SDL_GetKeyFromName(rightKey);
-
-        if (downKey && strcmp(downKey, "down") == 0)
-            m_DownKey = SDL_GetKeyFromName(downKey);
-
-        if (leftKey && strcmp(leftKey, "left") == 0)
-            m_LeftKey = SDL_GetKeyFromName(leftKey);
-        
-        if (shootKey && strcmp(shootKey, "space") == 0)
-            m_ShootKey = SDL_GetKeyFromName(shootKey);
+        g_InputMgr.BindKey(upKey,    INPUT_ACTION_UP);
+        g_InputMgr.BindKey(rightKey, INPUT_ACTION_RIGHT);
+        g_InputMgr.BindKey(downKey,  INPUT_ACTION_DOWN);
+        g_InputMgr.BindKey(leftKey,  INPUT_ACTION_LEFT);
+        g_InputMgr.BindKey(shootKey, INPUT_ACTION_SHOOT);
     }
 
     virtual ~KeyboardControl() {};
@@ -49,61 +48,29 @@ public:
     ///////////////////////////////////////////////////////
     
     virtual void Initialize() override {}
-    virtual void Render()     override {}
+    virtual void Render(RenderCommandBuffer& commands, const eLayerType layer) override {}
     
     ///////////////////////////////////////////////////////
     
     bool HandleKeysPressing()
     {
         // return: a flag to define if we pressed any key for moving
-        
-        const uint8_t* keys = SDL_GetKeyboardState(NULL);
-        bool isMoving = false;
 
-        glm::vec2 velocity = { 0, 0 };
-        const EntityID enttID = m_pOwner->GetID();
+        // held move actions of the current frame (from the devices or from a replay)
+        const uint32_t  moveMask = Game::ms_Input.heldActions & INPUT_ACTIONS_MOVE;
+        const MoveInfo& move     = GetMoveTable()[moveMask];
 
-        if (keys[SDL_SCANCODE_UP])
-        {
-            velocity.y = -1;
-            EventSwitchAnimation e(enttID, ANIMATION_TYPE_UP);
-            g_EventMgr.AddEvent(e);
-            isMoving = true;
-        }
-        if (keys[SDL_SCANCODE_DOWN])
-        {
-            velocity.y = 1;
-            EventSwitchAnimation e(enttID, ANIMATION_TYPE_DOWN);
-            g_EventMgr.AddEvent(e);
-            isMoving = true;
-        } 
-        if (keys[SDL_SCANCODE_RIGHT])
-        {
-            velocity.x = 1;
-            EventSwitchAnimation e(enttID, ANIMATION_TYPE_RIGHT);
-            g_EventMgr.AddEvent(e);
-            isMoving = true;
-        }
-        if (keys[SDL_SCANCODE_LEFT])
-        {
-            velocity.x = -1;
-            EventSwitchAnimation e(enttID, ANIMATION_TYPE_LEFT);
-            g_EventMgr.AddEvent(e);
-            isMoving = true;
-        }
+        if (!move.isMoving)
+            return false;
 
-        // normalize the velocity vector to prevent moving faster by diagonal
-        // and add an event for player moving
-        if (isMoving)
-        {
-            const float speed = g_GameStates.playerSpeed;
-            velocity = glm::normalize(velocity) * speed;
+        const EntityID  enttID   = m_pOwner->GetID();
+        const float     speed    = (float)g_GameStates.playerSpeed;
+        const glm::vec2 velocity = move.dir * speed;
 
-            EventPlayerMove e(enttID, velocity.x, velocity.y);
-            g_EventMgr.AddEvent(e);
-        }
+        g_EventMgr.AddEvent(EventSwitchAnimation(enttID, move.animType));
+        g_EventMgr.AddEvent(EventPlayerMove(enttID, velocity.x, velocity.y));
 
-        return isMoving;
+        return true;
     }
 
     ///////////////////////////////////////////////////////
@@ -111,20 +78,10 @@ public:
     void HandleKeysReleasing()
     {
         // if we released some key we set velocity to 0
-        if(Game::ms_Event.type == SDL_KEYUP)
+        if (Game::ms_Input.releasedActions & INPUT_ACTIONS_MOVE)
         {
-            switch(Game::ms_Event.key.keysym.sym)
-            {
-                case SDLK_UP:
-                case SDLK_DOWN:
-                case SDLK_RIGHT:
-                case SDLK_LEFT:
-                {
-                    const EntityID id = m_pOwner->GetID();
-                    g_EventMgr.AddEvent(EventPlayerStop(id));
-                    break;
-                }
-            }
+            const EntityID id = m_pOwner->GetID();
+            g_EventMgr.AddEvent(EventPlayerStop(id));
         }
     }
     
@@ -144,11 +101,45 @@ public:
     
 
 private:
-    SDL_Keycode m_UpKey = 0;
-    SDL_Keycode m_DownKey = 0;
-    SDL_Keycode m_RightKey = 0;
-    SDL_Keycode m_LeftKey = 0;
-    SDL_Keycode m_ShootKey = 0;
+    // a direction and animation for a combination of held move actions
+    struct MoveInfo
+    {
+        glm::vec2      dir      = { 0, 0 };     // normalized (so diagonal moving isn't faster)
+        eAnimationType animType = ANIMATION_TYPE_SINGLE;
+        bool           isMoving = false;
+    };
+
+    //-----------------------------------------------------
+    // Desc:  a table [held move actions mask => moving info] which is
+    //        computed only once; when opposite actions are held the later
+    //        one in order up/down/right/left wins (as does the animation)
+    //-----------------------------------------------------
+    static const MoveInfo* GetMoveTable()
+    {
+        static MoveInfo s_Table[INPUT_ACTIONS_MOVE + 1];
+        static bool     s_IsComputed = false;
+
+        if (s_IsComputed)
+            return s_Table;
+
+        for (uint32_t mask = 0; mask <= INPUT_ACTIONS_MOVE; ++mask)
+        {
+            MoveInfo& info = s_Table[mask];
+
+            if (mask & ActionBit(INPUT_ACTION_UP))    { info.dir.y = -1; info.animType = ANIMATION_TYPE_UP;    }
+            if (mask & ActionBit(INPUT_ACTION_DOWN))  { info.dir.y =  1; info.animType = ANIMATION_TYPE_DOWN;  }
+            if (mask & ActionBit(INPUT_ACTION_RIGHT)) { info.dir.x =  1; info.animType = ANIMATION_TYPE_RIGHT; }
+            if (mask & ActionBit(INPUT_ACTION_LEFT))  { info.dir.x = -1; info.animType = ANIMATION_TYPE_LEFT;  }
+
+            info.isMoving = (mask != 0);
+
+            if (info.isMoving)
+                info.dir = glm::normalize(info.dir);
+        }
+
+        s_IsComputed = true;
+        return s_Table;
+    }
 };
 
 #endif
@@ -1,7 +1,9 @@
 //===================================================================
 // Filename:  LifeTimer.h
 // Desc:      a component of the EC (Entity-Component) which
-//            is used to define the entity lifetime since its creation
+//            is used to define the entity lifetime since its creation;
+//            the entity destruction is scheduled only once in the timer
+//            wheel so we don't need to count the time each frame
 //
 // Created:   14.07.2025  by DimaSkup
 //===================================================================
@@ -11,51 +13,53 @@
 #include "../IComponent.h"
 #include "../EventMgr.h"
 #include "../EntityMgr.h"
+#include "../TimerWheel.h"
 
 
 class LifeTimer : public IComponent
 {
 public:
 
+    static constexpr eComponentType TYPE = COMPONENT_LIFE_TIMER;
+
     //-----------------------------------------------------
     // Desc:  a constructor of the LifeTimer component
     // Args:  - lifeTimeDurationMs: time in ms how long the 
     //                              entity will live
     //-----------------------------------------------------
     LifeTimer(const int lifeTimeDurationMs) :
-        m_FullLifeTimeMs((float)lifeTimeDurationMs),
-        m_CurrLifeMs(0) 
+        m_FullLifeTimeMs(lifeTimeDurationMs)
     {
     }
 
-    virtual ~LifeTimer()      {}
-    virtual void Initialize() {}
-    virtual void Render()     {}
-    
     //-----------------------------------------------------
-    // Desc:  update the entity current lifetime; if it is bigger
-    //        than its full life time then we will destroy this entt
-    // Args:  - deltaTime: the time (in sec) passed since the prev frame     
+    // Desc:  if the entity is destroyed earlier we don't need the timer
     //-----------------------------------------------------
-    virtual void Update(const float deltaTime)
+    virtual ~LifeTimer()
     {
-        m_CurrLifeMs += (int)(ceil(deltaTime*1000.0f));        
+        g_TimerWheel.Cancel(m_TimerID);
+    }
 
-        if (m_CurrLifeMs >= m_FullLifeTimeMs)
-        {
-            const EntityID id = GetOwner()->GetID();
-            g_EventMgr.AddEvent(EventDestroyEntity(id));
-        }
+    //-----------------------------------------------------
+    // Desc:  schedule destruction of the owner entity
+    //-----------------------------------------------------
+    virtual void Initialize()
+    {
+        const uint32_t delayMs = (m_FullLifeTimeMs > 0) ? (uint32_t)m_FullLifeTimeMs : 0;
+        m_TimerID = g_TimerWheel.ScheduleDestroy(GetOwner()->GetID(), delayMs);
     }
 
+    virtual void Update(const float deltaTime) {}
+    virtual void Render(RenderCommandBuffer& commands, const eLayerType layer) {}
+
     //-----------------------------------------------------
     // Desc:  get a name of this component
     //-----------------------------------------------------
     virtual const char* GetName() const override { return "LifeTimer (Component)"; }
 
 private:
-    int m_FullLifeTimeMs = 0;
-    int m_CurrLifeMs = 0;   // the time spent since entity creation
+    int     m_FullLifeTimeMs = 0;
+    TimerID m_TimerID        = INVALID_TIMER_ID;   // a scheduled destruction
 };
 
 #endif
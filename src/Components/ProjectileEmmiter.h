@@ -5,12 +5,18 @@
 #include "../IComponent.h"
 #include "../EntityMgr.h"
 #include "../EventMgr.h"
+#include "../TimerWheel.h"
 #include "Transform.h"
 #include "../../lib/glm/glm.hpp"
 
+// a projectile is destroyed anyway after this time
+constexpr uint32_t PROJECTILE_MAX_LIFETIME_MS = 4000;
+
 class ProjectileEmmiter : public IComponent
 {
 public:
+    static constexpr eComponentType TYPE = COMPONENT_PROJECTILE_EMITTER;
+
     ProjectileEmmiter(
         const int speed,
         const int angleDeg,
@@ -26,6 +32,7 @@ public:
 
     virtual ~ProjectileEmmiter()
     {
+        g_TimerWheel.Cancel(m_TimerID);
     }
 
     //-----------------------------------------------------
@@ -45,6 +52,8 @@ public:
         const float velocityX = cosf(m_AngleRad) * m_Speed;
         const float velocityY = sinf(m_AngleRad) * m_Speed;
         m_pTransform->m_Velocity = glm::vec2(velocityX, velocityY); 
+
+        ScheduleLifetimeEnd();
     }
 
     ///////////////////////////////////////////////////////
@@ -55,15 +64,13 @@ public:
         const int distanceSqr       = (int)glm::dot(distanceVec, distanceVec);
         const int rangeSqr          = m_Range*m_Range; 
 
-        m_Lifetime += deltaTime;
-
         // if we need to destroy/move this projectile
         if (distanceSqr > rangeSqr)
         {
             if (m_IsLoop)
             {
                 m_pTransform->m_Position = m_Origin;
-                m_Lifetime = 0;
+                ScheduleLifetimeEnd();
             }
             else
             {
@@ -71,26 +78,31 @@ public:
                 g_EventMgr.AddEvent(EventDestroyEntity(id));
             }
         }
-        
-        if (m_Lifetime >= 4000.0f)
-        {
-            const EntityID id = m_pOwner->GetID();
-            g_EventMgr.AddEvent(EventDestroyEntity(id));
-        }
     }
 
     ///////////////////////////////////////////////////////
 
     virtual const char* GetName() const { return "ProjectileEmmiter (Component)"; }
 
+private:
+    //-----------------------------------------------------
+    // Desc:  (re)start the lifetime of projectile: its destruction
+    //        is scheduled in the timer wheel instead of counting each frame
+    //-----------------------------------------------------
+    void ScheduleLifetimeEnd()
+    {
+        g_TimerWheel.Cancel(m_TimerID);
+        m_TimerID = g_TimerWheel.ScheduleDestroy(m_pOwner->GetID(), PROJECTILE_MAX_LIFETIME_MS);
+    }
+
 private:
     Transform* m_pTransform = nullptr;
     glm::vec2  m_Origin;               // position where appears
     int        m_Speed      = 0;       // speed in pixels
     int        m_Range      = 0;       // range in pixels where projectile is destroyed automatically
     float      m_AngleRad   = 0;       // angle in radians
-    float      m_Lifetime   = 0;       // lifetime of projectile since start of animation
     bool       m_IsLoop     = false;   // should emmiting repeat?
+    TimerID    m_TimerID    = INVALID_TIMER_ID;  // destruction when the lifetime is over
 };
 
 #endif
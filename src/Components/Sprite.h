@@ -15,6 +15,7 @@
 #include "../IComponent.h"
 #include "../AssetMgr.h"
 #include "../Render.h"
+#include "../RenderCommandBuffer.h"
 #include "../Animation.h"
 #include "Transform.h"
 #include <SDL2/SDL.h>
@@ -35,6 +36,8 @@ class Sprite : public IComponent
 {
 public:
 
+    static constexpr eComponentType TYPE = COMPONENT_SPRITE;
+
     //-----------------------------------------------------
     // Desc:   a constructor for animated sprites
     // Args:   - assetTexId:  identifier of the sprite sheet
@@ -212,7 +215,8 @@ public:
             return;
         }
 
-        m_pTexture = g_AssetMgr.GetTexture(assetTextureID); 
+        m_pTexture  = g_AssetMgr.GetTexture(assetTextureID); 
+        m_TextureID = g_AssetMgr.GetTextureID(assetTextureID);
 
         // check if we got a valid texture
         if (m_pTexture == nullptr)
@@ -225,6 +229,7 @@ public:
 
     inline const SDL_Rect& GetSrcRect() const { return m_SrcRect; }
     inline const SDL_Rect& GetDstRect() const { return m_DstRect; }
+    inline bool            IsVisible()  const { return m_IsVisible; }
 
 
     // ==============================================================
@@ -237,34 +242,82 @@ public:
         m_SrcRect.y = 0;
         m_SrcRect.w = m_pTransform->m_Width;
         m_SrcRect.h = m_pTransform->m_Height;
+
+        // compute rects and visibility right away: a sprite which is added
+        // after the animation system (an explosion from an event handler, etc.)
+        // is rendered in this frame before its first update
+        UpdateRects(0.0f, g_GameStates.cameraPosX, g_GameStates.cameraPosY);
     }
 
     ///////////////////////////////////////////////////////
     
     virtual void Update(const float deltaTime) override
+    {
+        UpdateRects(deltaTime, g_GameStates.cameraPosX, g_GameStates.cameraPosY);
+    }
+
+    //-----------------------------------------------------
+    // Desc:  update the position onto the screen and (only if the sprite
+    //        is on the screen) the animation frame; the animation time
+    //        goes on anyway so the frame is right when it becomes visible
+    // Args:  - cameraPosX, cameraPosY:  the current camera position
+    //-----------------------------------------------------
+    inline void UpdateRects(const float deltaTime, const uint cameraPosX, const uint cameraPosY)
     {
         m_AnimationTime += (deltaTime * 1000.0f);
 
+        // update the position onto the screen
+        m_DstRect.x = (int)(m_pTransform->m_Position.x - cameraPosX * !m_IsFixed);
+        m_DstRect.y = (int)(m_pTransform->m_Position.y - cameraPosY * !m_IsFixed);
+
+        m_DstRect.w = m_pTransform->m_Width  * m_pTransform->m_Scale;
+        m_DstRect.h = m_pTransform->m_Height * m_pTransform->m_Scale;
+
+        m_IsVisible = g_GameStates.IsOnScreen(m_DstRect.x, m_DstRect.y, m_DstRect.w, m_DstRect.h);
+
+        if (!m_IsVisible)
+            return;
+
         // update the animation
         if (m_IsAnimated)
         {
             m_SrcRect.x = m_SrcRect.w * (int)(((int)m_AnimationTime / m_AnimationSpeed) % m_NumFrames);
         }
         m_SrcRect.y = m_AnimationIdx * m_pTransform->m_Height;
+    }
 
-        // update the position onto the screen
-        m_DstRect.x = (int)(m_pTransform->m_Position.x - g_GameStates.cameraPosX * !m_IsFixed);
-        m_DstRect.y = (int)(m_pTransform->m_Position.y - g_GameStates.cameraPosY * !m_IsFixed);
+    //-----------------------------------------------------
+    // Desc:  update sprites [begin, end) of the input array (a function
+    //        of the animation system, see SystemScheduler) with no virtual
+    //        calls and the camera position is read only once
+    //-----------------------------------------------------
+    static void UpdateRange(
+        IComponent** ppComponents,
+        const int begin,
+        const int end,
+        const float deltaTime)
+    {
+        const uint cameraPosX = g_GameStates.cameraPosX;
+        const uint cameraPosY = g_GameStates.cameraPosY;
 
-        m_DstRect.w = m_pTransform->m_Width  * m_pTransform->m_Scale;
-        m_DstRect.h = m_pTransform->m_Height * m_pTransform->m_Scale;
+        for (int i = begin; i < end; ++i)
+            static_cast<Sprite*>(ppComponents[i])->UpdateRects(deltaTime, cameraPosX, cameraPosY);
     }
 
     ///////////////////////////////////////////////////////
 
-    virtual void Render() override
+    virtual void Render(RenderCommandBuffer& commands, const eLayerType layer) override
     {
-        Render::DrawRectTextured(m_pTexture, m_SrcRect, m_DstRect, m_SpriteFlip);
+        if (!m_IsVisible)
+        {
+            commands.AddCulled();
+            return;
+        }
+
+        // the depth is the bottom of the sprite on the screen
+        const uint64_t sortKey = MakeRenderKey(layer, m_DstRect.y + m_DstRect.h, m_TextureID);
+
+        commands.AddCommand(sortKey, m_pTexture, m_SrcRect, m_DstRect, m_SpriteFlip);
     }
 
     ///////////////////////////////////////////////////////
@@ -282,6 +335,7 @@ public:
 private:
     Transform*      m_pTransform     = nullptr;
     SDL_Texture*    m_pTexture       = nullptr;
+    uint16_t        m_TextureID      = 0;       // for sort keys of draw commands
     SDL_Rect        m_SrcRect;
     SDL_Rect        m_DstRect;
 
@@ -292,6 +346,7 @@ private:
     
     bool            m_IsAnimated     = false;     
     bool            m_IsFixed        = false;   // is always fixed at the same screen position
+    bool            m_IsVisible      = false;   // the dst rect is on the screen (otherwise it's culled)
 
     eAnimationType  m_CurrAnimationType = ANIMATION_TYPE_SINGLE;
     //std::string     m_CurrAnimationName;
@@ -21,6 +21,8 @@
 class TextLabel : public IComponent
 {
 public:
+    static constexpr eComponentType TYPE = COMPONENT_TEXT_LABEL;
+
     TextLabel(
         const int x,
         const int y,
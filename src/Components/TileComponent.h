@@ -4,6 +4,7 @@
 #include "../GameState.h"
 #include "../IComponent.h"
 #include "../Render.h"
+#include "../RenderCommandBuffer.h"
 #include "../AssetMgr.h"
 #include <SDL2/SDL.h>
 #include "../../lib/glm/glm.hpp"
@@ -12,6 +13,8 @@
 class TileComponent : public IComponent
 {
 public:
+    static constexpr eComponentType TYPE = COMPONENT_TILE;
+
     TileComponent(
         const int srcRectX,         // X-position of tile on tile texture 
         const int srcRectY,         // Y-position of tile on tile texture
@@ -25,7 +28,8 @@ public:
         m_DstRect {x, y, tileSize * tileScale, tileSize * tileScale},
         m_Position {x, y}
     {
-        m_pTexture = g_AssetMgr.GetTexture(assetTextureID);
+        m_pTexture  = g_AssetMgr.GetTexture(assetTextureID);
+        m_TextureID = g_AssetMgr.GetTextureID(assetTextureID);
     }
 
     ///////////////////////////////////////////////////////
@@ -43,16 +47,37 @@ public:
     
     virtual void Update(const float deltaTime) override 
     {
-        // update the tile's position according to the camera position
-        m_DstRect.x = m_Position.x - g_GameStates.cameraPosX;
-        m_DstRect.y = m_Position.y - g_GameStates.cameraPosY;
+        // tiles of the grid are updated only when they are visible (see EntityMgr::Update)
+        if (!m_IsIndexed)
+            UpdateRect(g_GameStates.cameraPosX, g_GameStates.cameraPosY);
+    }
+
+    //-----------------------------------------------------
+    // Desc:  update the tile's position according to the camera position
+    //        and check if the tile is on the screen
+    //-----------------------------------------------------
+    inline void UpdateRect(const uint cameraPosX, const uint cameraPosY)
+    {
+        m_DstRect.x = m_Position.x - cameraPosX;
+        m_DstRect.y = m_Position.y - cameraPosY;
+
+        m_IsVisible = g_GameStates.IsOnScreen(m_DstRect.x, m_DstRect.y, m_DstRect.w, m_DstRect.h);
     }
 
     ///////////////////////////////////////////////////////
 
-    virtual void Render() override
+    virtual void Render(RenderCommandBuffer& commands, const eLayerType layer) override
     {
-        Render::DrawRectTextured(m_pTexture, m_SrcRect, m_DstRect, SDL_FLIP_NONE);
+        if (!m_IsVisible)
+        {
+            commands.AddCulled();
+            return;
+        }
+
+        // tiles are flat (no depth) so all the tiles are grouped by texture
+        const uint64_t sortKey = MakeRenderKey(layer, 0, m_TextureID);
+
+        commands.AddCommand(sortKey, m_pTexture, m_SrcRect, m_DstRect, SDL_FLIP_NONE);
     }
 
     ///////////////////////////////////////////////////////
@@ -65,9 +90,13 @@ public:
 
 public:
     SDL_Texture* m_pTexture = nullptr;
+    uint16_t     m_TextureID = 0;
     SDL_Rect m_SrcRect;
     SDL_Rect m_DstRect;
     glm::vec2 m_Position;
+
+    bool m_IsVisible = false;       // the dst rect is on the screen (otherwise it's culled)
+    bool m_IsIndexed = false;       // is in the tile grid of EntityMgr
 };
 
 #endif
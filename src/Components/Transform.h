@@ -18,9 +18,35 @@
 #include "../Game.h"
 #include "../IComponent.h"
 #include "../Render.h"
+#include "../Map.h"
 #include "../../lib/glm/glm.hpp"
+#include <string.h>
+#include <stdint.h>
 
 
+// how many transforms are gathered for the vectorized integration at once
+constexpr int TRANSFORM_BATCH_SIZE = 64;
+
+//---------------------------------------------------------
+// Desc:  a branchless select: (cond) ? a : b; it's made by bit masks so
+//        a loop with it is vectorized by the compiler (a conditional
+//        expression with float comparison isn't, because of -ftrapping-math)
+//---------------------------------------------------------
+inline float SelectFloat(const bool cond, const float a, const float b)
+{
+    uint32_t bitsA, bitsB, bits;
+    memcpy(&bitsA, &a, sizeof(float));
+    memcpy(&bitsB, &b, sizeof(float));
+
+    const uint32_t mask = 0u - (uint32_t)cond;
+    bits = (bitsA & mask) | (bitsB & ~mask);
+
+    float res;
+    memcpy(&res, &bits, sizeof(float));
+    return res;
+}
+
+//---------------------------------------------------------
 
 struct TransformInitParams
 {
@@ -36,6 +62,8 @@ struct TransformInitParams
 class Transform : public IComponent
 {
 public:
+    static constexpr eComponentType TYPE = COMPONENT_TRANSFORM;
+
     Transform(const TransformInitParams& params) :
         m_Position(params.pos),
         m_Velocity(params.vel),
@@ -65,7 +93,7 @@ public:
     ///////////////////////////////////////////////////////
 
     virtual void Initialize() override {}
-    virtual void Render()     override {}
+    virtual void Render(RenderCommandBuffer& commands, const eLayerType layer) override {}
 
     ///////////////////////////////////////////////////////////
 
@@ -110,14 +138,116 @@ public:
     }
 
 
+    //-----------------------------------------------------
+    // Desc:  move over the tilemap: we are slowed down on "slow" tiles
+    //        and can't pass through tiles which block us
+    //-----------------------------------------------------
+    void MoveOverTerrain(const float deltaTime)
+    {
+        const SDL_Rect  rect    = { (int)m_Position.x, (int)m_Position.y, GetWidth(), GetHeight() };
+        const uint8_t   flags   = g_pMap->GetFlagsInRect(rect) & m_TerrainMask;
+        const float     factor  = (flags & TILE_FLAG_SLOW) ? TILE_SLOW_FACTOR : 1.0f;
+        const uint8_t   block   = m_TerrainMask & (TILE_FLAG_SOLID | TILE_FLAG_WATER);
+        const glm::vec2 prevPos = m_Position;
+
+        m_Position += (m_Velocity * (deltaTime * factor));
+        g_pMap->ResolveMove(prevPos, GetWidth(), GetHeight(), block, m_Position);
+    }
+
+    ///////////////////////////////////////////////////////////
+
     virtual void Update(const float deltaTime) override
     {
         // update the position/velocity as a function of deltaTime
-        m_Position += (m_Velocity * deltaTime);
+        if (m_TerrainMask && g_pMap)
+            MoveOverTerrain(deltaTime);
+        else
+            m_Position += (m_Velocity * deltaTime);
 
         ClampPosition(deltaTime);
     }
 
+    //-----------------------------------------------------
+    // Desc:  update transforms [begin, end) of the input array (a function
+    //        of the movement system, see SystemScheduler): transforms
+    //        which don't react to terrain are gathered by batches into
+    //        arrays of positions/velocities/sizes, so the integration
+    //        and clamping are vectorized; the result is exactly the same
+    //        as by Update() of each transform
+    //-----------------------------------------------------
+    static void UpdateRange(
+        IComponent** ppComponents,
+        const int begin,
+        const int end,
+        const float deltaTime)
+    {
+        Transform* transforms[TRANSFORM_BATCH_SIZE];
+        float      posX[TRANSFORM_BATCH_SIZE];
+        float      posY[TRANSFORM_BATCH_SIZE];
+        float      velX[TRANSFORM_BATCH_SIZE];
+        float      velY[TRANSFORM_BATCH_SIZE];
+        float      width[TRANSFORM_BATCH_SIZE];
+        float      height[TRANSFORM_BATCH_SIZE];
+
+        const float maxX = g_GameStates.levelMapWidth;
+        const float maxY = g_GameStates.levelMapHeight;
+
+        int i = begin;
+
+        while (i < end)
+        {
+            // gather a batch
+            int num = 0;
+
+            for (; i < end && num < TRANSFORM_BATCH_SIZE; ++i)
+            {
+                Transform* pT = static_cast<Transform*>(ppComponents[i]);
+
+                if (pT->m_TerrainMask && g_pMap)
+                {
+                    pT->Transform::Update(deltaTime);
+                    continue;
+                }
+
+                transforms[num] = pT;
+                posX[num]       = pT->m_Position.x;
+                posY[num]       = pT->m_Position.y;
+                velX[num]       = pT->m_Velocity.x;
+                velY[num]       = pT->m_Velocity.y;
+                width[num]      = (float)pT->GetWidth();
+                height[num]     = (float)pT->GetHeight();
+                ++num;
+            }
+
+            // the rest of the batch is zeroed, so the loop below has
+            // a constant number of iterations (it's fully vectorized)
+            for (int n = num; n < TRANSFORM_BATCH_SIZE; ++n)
+                posX[n] = posY[n] = velX[n] = velY[n] = width[n] = height[n] = 0;
+
+            // integrate and clamp (the same math as Update + ClampPosition),
+            // all the clamped values are computed so there are no branches
+            for (int n = 0; n < TRANSFORM_BATCH_SIZE; ++n)
+            {
+                const float x     = posX[n] + (velX[n] * deltaTime);
+                const float y     = posY[n] + (velY[n] * deltaTime);
+                const float nextX = x + (velX[n] * deltaTime);
+                const float nextY = y + (velY[n] * deltaTime);
+                const float highX = maxX - width[n] - 1;
+                const float highY = maxY - height[n] - 1;
+
+                const float clampedX = SelectFloat(nextX + width[n]  >= maxX, highX, x);
+                const float clampedY = SelectFloat(nextY + height[n] >= maxY, highY, y);
+
+                posX[n] = SelectFloat(nextX <= 0, 1.0f, clampedX);
+                posY[n] = SelectFloat(nextY <= 0, 1.0f, clampedY);
+            }
+
+            // scatter the batch back
+            for (int n = 0; n < num; ++n)
+                transforms[n]->m_Position = { posX[n], posY[n] };
+        }
+    }
+
     ///////////////////////////////////////////////////////////
 
     virtual const char* GetName() const override { return "Transform (Component)"; }
@@ -151,6 +281,7 @@ public:
     int m_Width = 0;
     int m_Height = 0;
     int m_Scale = 0;
+    uint8_t m_TerrainMask = 0;     // tile flags this entity reacts to (see eTileFlag)
 };
 
 #endif
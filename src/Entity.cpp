@@ -68,17 +68,25 @@ void Entity::Update(const float deltaTime)
     }
 }
 
-/////////////////////////////////////////////////
-
-void Entity::Render()
+//---------------------------------------------------------
+// Desc:  add draw commands of each component of this entity (if necessary)
+//---------------------------------------------------------
+void Entity::Render(RenderCommandBuffer& commands)
 {
-    // render each component of entity (if necessary)
     for (IComponent* pComponent : m_Components)
     {
-        pComponent->Render();
+        pComponent->Render(commands, m_Layer);
     }
 }
 
+//---------------------------------------------------------
+// Desc:  components lists of the entity manager's systems must be rebuilt
+//---------------------------------------------------------
+void Entity::OnComponentAdded()
+{
+    m_EnttMgr.OnComponentsChanged();
+}
+
 ///////////////////////////////////////////////////////////
 
 void Entity::ListAllComponents() const
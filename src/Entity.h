@@ -34,7 +34,7 @@ public:
     ~Entity();
 
     void Update(const float deltaTime);
-    void Render();
+    void Render(RenderCommandBuffer& commands);
 
     //-----------------------------------------------------
     // Desc:   destroy this entity on the next update of entity manager
@@ -57,9 +57,11 @@ public:
     {
         T* pNewComponent(new T(std::forward<TArgs>(args)...));   // create a new component object
         pNewComponent->m_pOwner = this;                          // setup an owner for this new component
+        pNewComponent->m_Type   = T::TYPE;                       // and its type for the systems scheduler
         m_Components.emplace_back(pNewComponent);                // store new component into the array of the entity components
         m_ComponentTypeMap[&typeid(*pNewComponent)] = pNewComponent; // make pair: [component_type => component_ptr]                                                            
         pNewComponent->Initialize();                             // and simply init this new component
+        OnComponentAdded();
 
         return *pNewComponent;
     }
@@ -88,6 +90,9 @@ public:
     
     void ListAllComponents() const;
 
+private:
+    void OnComponentAdded();
+
 public:
     EntityID                 m_ID = 0;
     eLayerType               m_Layer;
@@ -8,8 +8,12 @@
 #include "Components/Sprite.h"
 #include "Components/ProjectileEmmiter.h"
 #include "Components/LifeTimer.h"
+#include "Components/KeyboardControl.h"
+#include "Components/TileComponent.h"
 #include "AssetMgr.h"
 #include "EventMgr.h"
+#include "GameState.h"
+#include "JobSystem.h"
 #include <stdio.h>
 
 // init a global instance of the Entity manager
@@ -21,6 +25,66 @@ EntityMgr g_EntityMgr;
 EntityMgr::EntityMgr()
 {
     LogDbg(LOG, "constructor");
+    RegisterSystems();
+}
+
+//---------------------------------------------------------
+// Desc:   register update systems of components; the order is the same
+//         as the order of components in entities (so conflicting
+//         systems give the same result as the serial update):
+//         - input:       emits events                (main thread)
+//         - movement:    integrates positions        (parallel, vectorized)
+//         - animation:   sprite frames and dst rects (parallel, no virtual calls)
+//         - collider:    sync colliders to transform (parallel)
+//         - tiles:       dst rects of tiles          (parallel)
+//         - projectiles: range check, timers, events (main thread)
+//
+//         text labels and life timers have no update logic, so
+//         they are updated after all the systems (see Update)
+//---------------------------------------------------------
+void EntityMgr::RegisterSystems()
+{
+    SystemDesc input;
+    input.name   = "InputSystem";
+    input.type   = COMPONENT_KEYBOARD_CONTROL;
+    input.thread = SYSTEM_THREAD_MAIN;
+    m_Scheduler.AddSystem(input);
+
+    SystemDesc movement;
+    movement.name       = "MovementSystem";
+    movement.type       = COMPONENT_TRANSFORM;
+    movement.isParallel = true;
+    movement.func       = Transform::UpdateRange;
+    m_Scheduler.AddSystem(movement);
+
+    SystemDesc animation;
+    animation.name       = "AnimationSystem";
+    animation.type       = COMPONENT_SPRITE;
+    animation.reads      = ComponentBit(COMPONENT_TRANSFORM);
+    animation.isParallel = true;
+    animation.func       = Sprite::UpdateRange;
+    m_Scheduler.AddSystem(animation);
+
+    SystemDesc colliderSync;
+    colliderSync.name       = "ColliderSyncSystem";
+    colliderSync.type       = COMPONENT_COLLIDER;
+    colliderSync.reads      = ComponentBit(COMPONENT_TRANSFORM);
+    colliderSync.isParallel = true;
+    m_Scheduler.AddSystem(colliderSync);
+
+    SystemDesc tiles;
+    tiles.name       = "TileSystem";
+    tiles.type       = COMPONENT_TILE;
+    tiles.isParallel = true;
+    m_Scheduler.AddSystem(tiles);
+
+    SystemDesc projectiles;
+    projectiles.name   = "ProjectileSystem";
+    projectiles.type   = COMPONENT_PROJECTILE_EMITTER;
+    projectiles.reads  = ComponentBit(COMPONENT_TRANSFORM);
+    projectiles.writes = ComponentBit(COMPONENT_TRANSFORM);
+    projectiles.thread = SYSTEM_THREAD_MAIN;
+    m_Scheduler.AddSystem(projectiles);
 }
 
 ///////////////////////////////////////////////////////////
@@ -34,8 +98,13 @@ void EntityMgr::ClearData()
     }
 
     m_Entities.clear();
+    m_EnttsByIDs.clear();
     m_EnttsByNames.clear();
     m_EnttsByLayers.clear();
+    m_StaticColliders.Clear();
+    m_TileGrid.Clear();
+    m_VisibleTiles.clear();
+    m_ComponentListsDirty = true;
 }
 
 //---------------------------------------------------------
@@ -45,8 +114,82 @@ void EntityMgr::ClearData()
 //---------------------------------------------------------
 void EntityMgr::Update(const float deltaTime)
 {
+    UpdateVisibleTiles();
+
+    if (!m_ScheduledUpdate)
+    {
+        for (Entity* pEntt : m_Entities)
+            pEntt->Update(deltaTime);
+        return;
+    }
+
+    if (m_ComponentListsDirty)
+        BuildComponentLists();
+
+    m_Scheduler.Run(m_ComponentLists, deltaTime);
+
+    for (IComponent* pComponent : m_Unscheduled)
+        pComponent->Update(deltaTime);
+}
+
+//---------------------------------------------------------
+// Desc:   the visibility pass of tiles of the grid: only tiles which
+//         are found by the camera rect are updated, the others are
+//         culled with no work at all (they aren't even in lists of systems)
+//---------------------------------------------------------
+void EntityMgr::UpdateVisibleTiles()
+{
+    if (m_TileGrid.IsEmpty())
+        return;
+
+    const uint     cameraPosX = g_GameStates.cameraPosX;
+    const uint     cameraPosY = g_GameStates.cameraPosY;
+    const SDL_Rect camera     = {
+        (int)cameraPosX,
+        (int)cameraPosY,
+        (int)g_GameStates.windowWidth,
+        (int)g_GameStates.windowHeight };
+
+    // tiles of the previous frame are hidden unless the query finds them again
+    for (TileComponent* pTile : m_VisibleTiles)
+        pTile->m_IsVisible = false;
+
+    m_TileGrid.Query(camera, m_VisibleTiles);
+
+    for (TileComponent* pTile : m_VisibleTiles)
+        pTile->UpdateRect(cameraPosX, cameraPosY);
+}
+
+//---------------------------------------------------------
+// Desc:   gather components of each type for the systems (in order of
+//         entities); it's done only when entities or components were
+//         added/removed since the previous update
+//---------------------------------------------------------
+void EntityMgr::BuildComponentLists()
+{
+    for (std::vector<IComponent*>& components : m_ComponentLists)
+        components.clear();
+
+    m_Unscheduled.clear();
+
     for (Entity* pEntt : m_Entities)
-        pEntt->Update(deltaTime);
+    {
+        for (IComponent* pComponent : pEntt->m_Components)
+        {
+            const eComponentType type = pComponent->m_Type;
+
+            // tiles of the grid are updated by the visibility pass
+            if (type == COMPONENT_TILE && static_cast<TileComponent*>(pComponent)->m_IsIndexed)
+                continue;
+
+            if (type < NUM_COMPONENT_TYPES && m_Scheduler.HasSystem(type))
+                m_ComponentLists[type].push_back(pComponent);
+            else
+                m_Unscheduled.push_back(pComponent);
+        }
+    }
+
+    m_ComponentListsDirty = false;
 }
 
 //---------------------------------------------------------
@@ -56,6 +199,11 @@ void EntityMgr::Update(const float deltaTime)
 void EntityMgr::DestroyEntt(const EntityID id)
 {
     Entity* pEntt = GetEnttByID(id);
+
+    // the entity can be already destroyed by another event
+    if (!pEntt)
+        return;
+
     const char*      name  = pEntt->GetName();
     const eLayerType layer = pEntt->GetLayer();
 
@@ -91,6 +239,29 @@ void EntityMgr::DestroyEntt(const EntityID id)
         LogErr(LOG, "there is no entt by layer: %d", (int)layer);
     }
 
+    // static colliders grid stores a ptr to the collider so exclude it
+    if (pEntt->HasComponent<Collider>())
+    {
+        const Collider* pCollider = pEntt->GetComponent<Collider>();
+        if (pCollider->IsStatic())
+            m_StaticColliders.Remove(pCollider);
+    }
+
+    // the same for the tile grid (and the visible tiles of the current frame)
+    if (pEntt->HasComponent<TileComponent>())
+    {
+        TileComponent* pTile = pEntt->GetComponent<TileComponent>();
+
+        if (pTile->m_IsIndexed)
+        {
+            m_TileGrid.Remove(pTile);
+
+            const auto itVisible = std::find(m_VisibleTiles.begin(), m_VisibleTiles.end(), pTile);
+            if (itVisible != m_VisibleTiles.end())
+                m_VisibleTiles.erase(itVisible);
+        }
+    }
+
     // TODO: for debug
     LogMsg("entt is destroyed: %s", name);
 
@@ -105,26 +276,20 @@ void EntityMgr::DestroyEntt(const EntityID id)
     // remove a record from entities array
     m_Entities[idx] = m_Entities.back();
     m_Entities.pop_back();
+
+    m_ComponentListsDirty = true;
 }
 
 //---------------------------------------------------------
-// Desc:   go through each rendering layer type and 
-//         render in order all the entities;
-//         so entities with a higher layer type will be rendered
-//         over the entts with a lower layer type
+// Desc:   add draw commands of all the entities into the buffer;
+//         the order of drawing is defined by sort keys of commands
+//         (layer, depth, texture) so entities are simply added in order
+//         of the array, and the buffer must be sorted before drawing
 //---------------------------------------------------------
-void EntityMgr::Render()
+void EntityMgr::Render(RenderCommandBuffer& commands)
 {
-    for (int layerIdx = 0; layerIdx < eLayerType::NUM_LAYERS; ++layerIdx)
-    { 
-        const std::vector<Entity*>* pEntts = GetEnttsByLayer(eLayerType(layerIdx));
-
-        if (!pEntts)  // we have no entts by the current layer
-            continue;
-
-        for (Entity* pEntt : *pEntts)
-            pEntt->Render();
-    }
+    for (Entity* pEntt : m_Entities)
+        pEntt->Render(commands);
 }
 
 //---------------------------------------------------------
@@ -150,6 +315,8 @@ Entity& EntityMgr::AddEntity(const char* enttName, const eLayerType layer)
     m_EnttsByNames.insert({ enttName, pEntt });
     m_EnttsByLayers[layer].emplace_back(pEntt);    // add this entt into the map of entities by layers (so we relate this entity to particular layer)
 
+    m_ComponentListsDirty = true;
+
     return *pEntt;
 }
 
@@ -160,9 +327,11 @@ Entity& EntityMgr::AddEntity(const char* enttName, const eLayerType layer)
 //---------------------------------------------------
 Entity* EntityMgr::GetEnttByID(const EntityID id)
 {
-    if (m_EnttsByIDs.find(id) != m_EnttsByIDs.end())
+    const auto it = m_EnttsByIDs.find(id);
+
+    if (it != m_EnttsByIDs.end())
     {
-        return m_EnttsByIDs[id];
+        return it->second;
     }
     else
     {
@@ -247,69 +416,240 @@ void EntityMgr::SetPlayer(Entity* pEntt)
     }
 }
 
-///////////////////////////////////////////////////////////
+//---------------------------------------------------------
+// Desc:   put all the colliders which were marked as static
+//         into the grid; is called once after the level is loaded
+//---------------------------------------------------------
+void EntityMgr::BuildStaticColliders()
+{
+    std::vector<const Collider*> staticColliders;
+    staticColliders.reserve(64);
+
+    for (Entity* pEntt : m_Entities)
+    {
+        if (!pEntt->HasComponent<Collider>())
+            continue;
+
+        Collider* pCollider = pEntt->GetComponent<Collider>();
+        if (pCollider->IsStatic())
+            staticColliders.push_back(pCollider);
+    }
+
+    m_StaticColliders.Build(
+        staticColliders,
+        (int)g_GameStates.levelMapWidth,
+        (int)g_GameStates.levelMapHeight);
+}
 
+//---------------------------------------------------------
+// Desc:   put all the tiles into the grid; is called once after
+//         the level is loaded (tiles added after it are updated
+//         and culled one by one as usual)
+//---------------------------------------------------------
+void EntityMgr::BuildTileGrid()
+{
+    std::vector<TileComponent*> tiles;
+    tiles.reserve(m_Entities.size());
+
+    for (TileComponent* pTile : m_VisibleTiles)
+        pTile->m_IsVisible = false;
+
+    m_VisibleTiles.clear();
+
+    for (Entity* pEntt : m_Entities)
+    {
+        if (!pEntt->HasComponent<TileComponent>())
+            continue;
+
+        TileComponent* pTile = pEntt->GetComponent<TileComponent>();
+        pTile->m_IsIndexed = true;
+        pTile->m_IsVisible = false;
+        tiles.push_back(pTile);
+    }
+
+    m_TileGrid.Build(
+        tiles,
+        (int)g_GameStates.levelMapWidth,
+        (int)g_GameStates.levelMapHeight);
+
+    // indexed tiles are excluded from lists of systems
+    m_ComponentListsDirty = true;
+}
+
+//---------------------------------------------------------
+// Desc:   check if collision btw two colliders (in this order)
+//         causes any reaction (see HandleCollision)
+//---------------------------------------------------------
+static inline bool IsReactivePair(const eColliderTag tag1, const eColliderTag tag2)
+{
+    return ((tag1 == PLAYER) && (tag2 == PROJECTILE || tag2 == LEVEL_COMPLETE)) ||
+           ((tag1 == ENEMY)  && (tag2 == FRIENDLY_PROJECTILE));
+}
+
+//---------------------------------------------------------
+// Desc:   test dynamic colliders with each other and against
+//         the grid of static colliders; the narrowphase is split
+//         into chunks over the job system, and each chunk posts events
+//         of its contacts with keys (chunk, contact), so after draining
+//         the events are in the same order as for the serial path;
+//         as the serial path stops at the first contact with the level
+//         complete zone, the events posted after its key are discarded
+// Ret:    PLAYER_LEVEL_COMPLETE_COLLISION if the player reached
+//         the level complete zone, or NO_COLLISION otherwise
+//---------------------------------------------------------
 eCollisionType EntityMgr::CheckCollisions() const
 {
-    std::vector<Entity*> entitiesWithCollider;
-    entitiesWithCollider.reserve(64);
+    std::vector<const Collider*>& dynamicColliders = m_DynamicColliders;
+    dynamicColliders.clear();
 
-    // get entities which have collider component
+    // get dynamic colliders (static ones are already in the grid)
     for (Entity* pEntt : m_Entities)
     {
-        if (pEntt->HasComponent<Collider>())
-            entitiesWithCollider.push_back(pEntt);
+        if (!pEntt->HasComponent<Collider>())
+            continue;
+
+        const Collider* pCollider = pEntt->GetComponent<Collider>();
+        if (!pCollider->IsStatic())
+            dynamicColliders.push_back(pCollider);
     }
 
-    // test each entity to collision with each other
-    for (Entity* pEntt : entitiesWithCollider)
+    if (dynamicColliders.empty())
+        return NO_COLLISION;
+
+    // each chunk writes contacts into its own buffer so we don't need any sync
+    const int numColliders = (int)dynamicColliders.size();
+    const int chunkSize    = (m_ParallelCollisions) ? COLLISION_CHUNK_SIZE : numColliders;
+    const int numChunks    = JobSystem::GetNumChunks(numColliders, chunkSize);
+
+    if ((int)m_ContactBuffers.size() < numChunks)
+        m_ContactBuffers.resize(numChunks);
+
+    // the smallest key of a contact with the level complete zone
+    std::atomic<uint64_t> levelCompleteKey{UINT64_MAX};
+
+    g_JobSystem.ParallelFor(numColliders, chunkSize,
+        [this, &levelCompleteKey](const int chunkIdx, const int begin, const int end)
+        {
+            std::vector<CollisionContact>& contacts = m_ContactBuffers[chunkIdx];
+            FindContacts(begin, end, contacts);
+
+            for (uint32_t i = 0; i < (uint32_t)contacts.size(); ++i)
+            {
+                const uint64_t orderKey = MakeEventOrderKey((uint32_t)chunkIdx, i);
+
+                if (HandleCollision(contacts[i].pCollider1, contacts[i].pCollider2, orderKey) == NO_COLLISION)
+                    continue;
+
+                // the rest contacts of this chunk would be discarded anyway
+                uint64_t minKey = levelCompleteKey.load(std::memory_order_relaxed);
+
+                while (orderKey < minKey &&
+                       !levelCompleteKey.compare_exchange_weak(minKey, orderKey, std::memory_order_relaxed)) {}
+                break;
+            }
+        });
+
+    const uint64_t cutoffKey = levelCompleteKey.load();
+
+    if (cutoffKey == UINT64_MAX)
+        return NO_COLLISION;
+
+    g_EventMgr.DiscardPostedAfter(cutoffKey);
+    return PLAYER_LEVEL_COMPLETE_COLLISION;
+}
+
+//---------------------------------------------------------
+// Desc:   find contacts of dynamic colliders in range [begin, end)
+//         with all the other dynamic colliders, and with static ones
+//         (in both directions because only the first collider in pair
+//         defines the reaction); can be called from any thread
+// Out:    - outContacts: pairs of colliders which need a reaction
+//---------------------------------------------------------
+void EntityMgr::FindContacts(
+    const int begin,
+    const int end,
+    std::vector<CollisionContact>& outContacts) const
+{
+    const std::vector<const Collider*>& dynamicColliders = m_DynamicColliders;
+
+    std::vector<const Collider*> staticColliders;
+    staticColliders.reserve(16);
+    outContacts.clear();
+
+    for (int i = begin; i < end; ++i)
     {
-        const Collider* pCollider1    = pEntt->GetComponent<Collider>();
-        const SDL_Rect& colliderRect1 = pCollider1->m_ColliderRect;     // collider rectangle of the curr entity
-        const eColliderTag cTag       = pCollider1->m_ColliderTag;      // collider tag of the curr entity
+        const Collider*    pCollider1    = dynamicColliders[i];
+        const SDL_Rect&    colliderRect1 = pCollider1->m_ColliderRect;
+        const eColliderTag cTag          = pCollider1->m_ColliderTag;
+
+        // test with other dynamic colliders
+        for (const Collider* pCollider2 : dynamicColliders)
+        {
+            if (!IsReactivePair(cTag, pCollider2->m_ColliderTag))
+                continue;
 
-        // test with other entities
-        for (Entity* pOtherEntt : entitiesWithCollider)
+            if (Collision::CheckRectCollision(colliderRect1, pCollider2->m_ColliderRect))
+                outContacts.push_back({ pCollider1, pCollider2 });
+        }
+
+        // test with static colliders
+        m_StaticColliders.Query(colliderRect1, staticColliders);
+
+        for (const Collider* pStatic : staticColliders)
         {
-            const Collider* pCollider2    = pOtherEntt->GetComponent<Collider>();
-            const SDL_Rect& colliderRect2 = pCollider2->m_ColliderRect;
+            if (IsReactivePair(cTag, pStatic->m_ColliderTag))
+                outContacts.push_back({ pCollider1, pStatic });
 
-            if (Collision::CheckRectCollision(colliderRect1, colliderRect2))
+            if (IsReactivePair(pStatic->m_ColliderTag, cTag))
+                outContacts.push_back({ pStatic, pCollider1 });
+        }
+    }
+}
+
+//---------------------------------------------------------
+// Desc:   react to collision btw two colliders: the first one
+//         defines what kind of reaction we have; can be called
+//         from any thread since events are only posted
+// Args:   - orderKey: a key to order posted events (see MakeEventOrderKey)
+// Ret:    PLAYER_LEVEL_COMPLETE_COLLISION if the player reached
+//         the level complete zone, or NO_COLLISION otherwise
+//---------------------------------------------------------
+eCollisionType EntityMgr::HandleCollision(
+    const Collider* pCollider1,
+    const Collider* pCollider2,
+    const uint64_t orderKey) const
+{
+    const eColliderTag cTag  = pCollider1->m_ColliderTag;
+    const eColliderTag cTag2 = pCollider2->m_ColliderTag;
+
+    // if the current entity is the player
+    if (cTag == eColliderTag::PLAYER)
+    {
+        switch (cTag2)
+        {
+            case PROJECTILE:    
+            {
+                const EntityID projectileID = pCollider2->GetOwner()->GetID();
+                g_EventMgr.PostEvent(EventPlayerHitEnemyProjectile(projectileID), orderKey);
+                break;
+            }
+            case LEVEL_COMPLETE: 
             {
-                const eColliderTag cTag2 = pCollider2->m_ColliderTag;
-
-                // if the current entity is the player
-                if (cTag == eColliderTag::PLAYER)
-                {
-                    switch (cTag2)
-                    {
-                        case PROJECTILE:    
-                        {
-                            //const EntityID playerID = pCollider1->GetOwner()->GetID();
-                            const EntityID projectileID = pCollider2->GetOwner()->GetID();
-                            g_EventMgr.AddEvent(EventPlayerHitEnemyProjectile(projectileID));
-                            break;
-                        }
-                        case LEVEL_COMPLETE: 
-                        {
-                            return PLAYER_LEVEL_COMPLETE_COLLISION;
-                        }
-                    } 
-                }
-
-                // else we maybe have collision btw enemy and smth
-                else if (cTag == eColliderTag::ENEMY)
-                {
-                    if (cTag2 == FRIENDLY_PROJECTILE)
-                    {
-                        const EntityID enemyID      = pCollider1->GetOwner()->GetID();
-                        const EntityID projectileID = pCollider2->GetOwner()->GetID();
-
-                        g_EventMgr.AddEvent(EventKillEnemy(enemyID));
-                        g_EventMgr.AddEvent(EventDestroyEntity(projectileID)); 
-                    }
-                }
+                return PLAYER_LEVEL_COMPLETE_COLLISION;
             }
+        } 
+    }
+
+    // else we maybe have collision btw enemy and smth
+    else if (cTag == eColliderTag::ENEMY)
+    {
+        if (cTag2 == FRIENDLY_PROJECTILE)
+        {
+            const EntityID enemyID      = pCollider1->GetOwner()->GetID();
+            const EntityID projectileID = pCollider2->GetOwner()->GetID();
+
+            g_EventMgr.PostEvent(EventKillEnemy(enemyID), orderKey);
+            g_EventMgr.PostEvent(EventDestroyEntity(projectileID), orderKey);
         }
     }
 
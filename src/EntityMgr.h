@@ -9,11 +9,26 @@
 #include "Types.h"
 #include "Entity.h"
 #include "Collision.h"           // collision math tests
+#include "StaticColliderGrid.h"
+#include "TileGrid.h"
 #include "IComponent.h"
+#include "SystemScheduler.h"
 #include <vector>
 #include <map>
 #include <string>
 
+class Collider;
+
+// a pair of colliders which intersect and need some reaction
+struct CollisionContact
+{
+    const Collider* pCollider1;          // this one defines the reaction
+    const Collider* pCollider2;
+};
+
+// how many dynamic colliders are tested by a single job of the job system
+constexpr int COLLISION_CHUNK_SIZE = 64;
+
 class EntityMgr
 {
 public:
@@ -23,7 +38,7 @@ public:
     void Update(const float deltaTime);
     void DestroyEntt(const EntityID id);
 //    void DestroyInactiveEntts();
-    void Render();
+    void Render(RenderCommandBuffer& commands);
 
     inline bool HasNoEntts()  const { return m_Entities.empty(); }
     inline uint GetNumEntts() const { return m_Entities.size(); }
@@ -42,11 +57,34 @@ public:
     Entity* GetEnttByName(const char* name);
 
     // collision tests
+    void           BuildStaticColliders();
+    void           BuildTileGrid();
     eCollisionType CheckCollisions() const;
     eColliderTag   CheckEnttCollisions(Entity* pEntt) const;
 
+    inline void SetParallelCollisions(const bool state) { m_ParallelCollisions = state; }
+    inline void SetScheduledUpdate(const bool state)    { m_ScheduledUpdate = state; }
+
+    // components lists of systems are rebuilt on the next update
+    inline void OnComponentsChanged() { m_ComponentListsDirty = true; }
+
     EntityID m_LastEnttID = 0;
 
+private:
+    void RegisterSystems();
+    void BuildComponentLists();
+    void UpdateVisibleTiles();
+
+    void FindContacts(
+        const int begin,
+        const int end,
+        std::vector<CollisionContact>& outContacts) const;
+
+    eCollisionType HandleCollision(
+        const Collider* pCollider1,
+        const Collider* pCollider2,
+        const uint64_t orderKey) const;
+
 private:
     Entity*              m_pPlayer = nullptr;
     std::vector<Entity*> m_Entities;
@@ -54,6 +92,23 @@ private:
     std::map<EntityID, Entity*>                m_EnttsByIDs;
     std::map<std::string, Entity*>             m_EnttsByNames;
     std::map<eLayerType, std::vector<Entity*>> m_EnttsByLayers;
+
+    StaticColliderGrid   m_StaticColliders;    // is built once per level
+    TileGrid             m_TileGrid;           // is built once per level
+
+    std::vector<TileComponent*> m_VisibleTiles; // tiles of the grid which are visible in the current frame
+    bool                 m_ParallelCollisions = true;
+
+    // update of components by systems (see RegisterSystems)
+    SystemScheduler          m_Scheduler;
+    ComponentLists           m_ComponentLists;
+    std::vector<IComponent*> m_Unscheduled;    // components which have no system
+    bool                     m_ScheduledUpdate = true;
+    bool                     m_ComponentListsDirty = true;
+
+    // collision tests scratch: dynamic colliders and contacts per each chunk
+    mutable std::vector<const Collider*>                m_DynamicColliders;
+    mutable std::vector<std::vector<CollisionContact>>  m_ContactBuffers;
 };
 
 // =================================================================================
@@ -4,6 +4,8 @@
 #include "Types.h"
 #include <string.h>
 
+// NOTE: events are dispatched by types in order of this enum
+//       (all the events of one type, then all the events of the next type, etc.)
 enum eEventType
 {
     EVENT_TYPE_SWITCH_ANIMATION,
@@ -13,107 +15,115 @@ enum eEventType
     EVENT_TYPE_PLAYER_STOP,     // doesn't move (velocity is zero)
     EVENT_TYPE_PLAYER_HIT_ENEMY_PROJECTILE,
 
-    EVENT_TYPE_DESTROY_ENTITY,    
+    EVENT_TYPE_DESTROY_ENTITY,
     EVENT_TYPE_KILL_ENEMY,
-};
 
-// ==================================================================
-// Basic event
-// ==================================================================
-struct Event
-{
-    eEventType type;
-    EntityID id;
-    float x;
-    float y;
-    float z;
-    float w;
+    NUM_EVENT_TYPES,
 };
 
 // ==================================================================
-// Concrete events
+// Concrete events: each one contains only its own data and
+// a static TYPE which defines a channel of the event manager
 // ==================================================================
-struct EventSwitchAnimation : public Event
+struct EventSwitchAnimation
 {
+    static constexpr eEventType TYPE = EVENT_TYPE_SWITCH_ANIMATION;
+
+    EventSwitchAnimation() {}
     EventSwitchAnimation(
         const EntityID enttID,
         const eAnimationType inAnimType)
+        :
+        id(enttID),
+        animType(inAnimType)
     {
-        id   = enttID;
-        type = EVENT_TYPE_SWITCH_ANIMATION;
-        x    = (float)inAnimType;
-    } 
+    }
+
+    EntityID       id       = 0;
+    eAnimationType animType = ANIMATION_TYPE_SINGLE;
 };
 
 ///////////////////////////////////////////////////////////
 
-struct EventPlayerShoot : public Event
+struct EventPlayerShoot
 {
-    EventPlayerShoot(const EntityID enttID)
-    {
-        id = enttID;
-        type = EVENT_TYPE_PLAYER_SHOOT;
-    }
+    static constexpr eEventType TYPE = EVENT_TYPE_PLAYER_SHOOT;
+
+    EventPlayerShoot() {}
+    EventPlayerShoot(const EntityID enttID) : id(enttID) {}
+
+    EntityID id = 0;
 };
 
 ///////////////////////////////////////////////////////////
 
-struct EventPlayerMove : public Event
+struct EventPlayerMove
 {
+    static constexpr eEventType TYPE = EVENT_TYPE_PLAYER_MOVE;
+
+    EventPlayerMove() {}
     EventPlayerMove(
-        const EntityID enttID, 
+        const EntityID enttID,
         const float velocityX,
         const float velocityY)
+        :
+        id(enttID),
+        velX(velocityX),
+        velY(velocityY)
     {
-        id   = enttID;
-        type = EVENT_TYPE_PLAYER_MOVE;
-        x    = velocityX;
-        y    = velocityY;
     }
+
+    EntityID id   = 0;
+    float    velX = 0;
+    float    velY = 0;
 };
 
 ///////////////////////////////////////////////////////////
 
-struct EventPlayerStop : public Event
+struct EventPlayerStop
 {
-    EventPlayerStop(const EntityID enttID)
-    {
-        id = enttID;
-        type = EVENT_TYPE_PLAYER_STOP;
-    }
+    static constexpr eEventType TYPE = EVENT_TYPE_PLAYER_STOP;
+
+    EventPlayerStop() {}
+    EventPlayerStop(const EntityID enttID) : id(enttID) {}
+
+    EntityID id = 0;
 };
 
 ///////////////////////////////////////////////////////////
 
-struct EventPlayerHitEnemyProjectile : public Event
+struct EventPlayerHitEnemyProjectile
 {
-    EventPlayerHitEnemyProjectile(const EntityID enttID)
-    {
-        id = enttID;
-        type = EVENT_TYPE_PLAYER_HIT_ENEMY_PROJECTILE;
-    }
+    static constexpr eEventType TYPE = EVENT_TYPE_PLAYER_HIT_ENEMY_PROJECTILE;
+
+    EventPlayerHitEnemyProjectile() {}
+    EventPlayerHitEnemyProjectile(const EntityID enttID) : id(enttID) {}
+
+    EntityID id = 0;            // projectile's ID
 };
 
 ///////////////////////////////////////////////////////////
 
-struct EventDestroyEntity : public Event
+struct EventDestroyEntity
 {
-    EventDestroyEntity(const EntityID enttID)
-    {
-        id = enttID;
-        type = EVENT_TYPE_DESTROY_ENTITY;
-    }
+    static constexpr eEventType TYPE = EVENT_TYPE_DESTROY_ENTITY;
+
+    EventDestroyEntity() {}
+    EventDestroyEntity(const EntityID enttID) : id(enttID) {}
+
+    EntityID id = 0;
 };
 
 ///////////////////////////////////////////////////////////
 
-struct EventKillEnemy : public Event
+struct EventKillEnemy
 {
-    EventKillEnemy(const EntityID enemyID)
-    {
-        id = enemyID;
-        type = EVENT_TYPE_KILL_ENEMY;
-    }
+    static constexpr eEventType TYPE = EVENT_TYPE_KILL_ENEMY;
+
+    EventKillEnemy() {}
+    EventKillEnemy(const EntityID enemyID) : id(enemyID) {}
+
+    EntityID id = 0;
 };
 
 #endif
@@ -9,3 +9,69 @@
 EventMgr g_EventMgr;
 
 
+//---------------------------------------------------------
+// Desc:   create a channel for each event type (only once,
+//         so later adding/dispatching of events doesn't allocate)
+//---------------------------------------------------------
+EventMgr::EventMgr()
+{
+    m_Channels[EVENT_TYPE_SWITCH_ANIMATION]             = new EventChannel<EventSwitchAnimation>();
+    m_Channels[EVENT_TYPE_PLAYER_SHOOT]                 = new EventChannel<EventPlayerShoot>();
+    m_Channels[EVENT_TYPE_PLAYER_MOVE]                  = new EventChannel<EventPlayerMove>();
+    m_Channels[EVENT_TYPE_PLAYER_STOP]                  = new EventChannel<EventPlayerStop>();
+    m_Channels[EVENT_TYPE_PLAYER_HIT_ENEMY_PROJECTILE]  = new EventChannel<EventPlayerHitEnemyProjectile>();
+    m_Channels[EVENT_TYPE_DESTROY_ENTITY]               = new EventChannel<EventDestroyEntity>();
+    m_Channels[EVENT_TYPE_KILL_ENEMY]                   = new EventChannel<EventKillEnemy>();
+}
+
+///////////////////////////////////////////////////////////
+
+EventMgr::~EventMgr()
+{
+    for (IEventChannel*& pChannel : m_Channels)
+    {
+        delete pChannel;
+        pChannel = nullptr;
+    }
+}
+
+//---------------------------------------------------------
+// Desc:   move events which were posted from worker threads
+//         into the queues of their channels
+//---------------------------------------------------------
+void EventMgr::DrainPosted()
+{
+    for (IEventChannel* pChannel : m_Channels)
+        pChannel->DrainPosted();
+}
+
+//---------------------------------------------------------
+// Desc:   discard posted events of all the types with keys greater
+//         than the input one (see EventChannel::DiscardPostedAfter)
+//---------------------------------------------------------
+void EventMgr::DiscardPostedAfter(const uint64_t orderKey)
+{
+    for (IEventChannel* pChannel : m_Channels)
+        pChannel->DiscardPostedAfter(orderKey);
+}
+
+//---------------------------------------------------------
+// Desc:   pass all the queued events to their subscribers
+//         (channel by channel in order of event types)
+//---------------------------------------------------------
+void EventMgr::Dispatch()
+{
+    DrainPosted();
+
+    for (IEventChannel* pChannel : m_Channels)
+        pChannel->Dispatch();
+}
+
+//---------------------------------------------------------
+// Desc:   drop all the queued events
+//---------------------------------------------------------
+void EventMgr::Clear()
+{
+    for (IEventChannel* pChannel : m_Channels)
+        pChannel->Clear();
+}
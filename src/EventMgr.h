@@ -1,6 +1,17 @@
 //===================================================================
 // Filename:  EventMgr.h
-// Desc:      something like the EventBus pattern
+// Desc:      something like the EventBus pattern:
+//            - each event type has its own channel: a preallocated
+//              ring buffer + a list of subscribers for this type
+//            - systems subscribe to particular event types
+//            - dispatching is a tight loop over each channel's queue
+//              (no allocations, no switch by type)
+//            - a channel can coalesce events at enqueue time so handlers
+//              see at most one event per entity per dispatch
+//            - worker threads post events into a lock-free queue of
+//              the channel; before dispatching the main thread drains it
+//              in order of keys which are given by posters, so the result
+//              doesn't depend on threads timing
 //
 // Created:   01.07.2025  by DimaSkup
 //===================================================================
@@ -8,18 +19,347 @@
 #define EVENT_MGR_H
 
 #include "Event.h"
-#include <deque>
+#include "Log.h"
+#include "MPSCQueue.h"
+#include <vector>
+#include <algorithm>
 
-class EventMgr
+constexpr int EVENT_QUEUE_CAPACITY = 4096;    // max num of events per type per frame (power of 2)
+constexpr int MAX_EVENT_SUBSCRIBERS = 8;      // max num of subscribers per event type
+
+//---------------------------------------------------------
+// Desc:  make a key to order events which are posted from worker threads:
+//        for instance by chunk index and by index of event within the chunk
+//        (keys of one event type must be unique)
+//---------------------------------------------------------
+inline uint64_t MakeEventOrderKey(const uint32_t major, const uint32_t minor)
+{
+    return ((uint64_t)major << 32) | minor;
+}
+
+// how events of the same type for the same entity are coalesced
+enum eCoalescePolicy
+{
+    COALESCE_NONE,                  // each event is dispatched
+    COALESCE_LAST_WRITER_WINS,      // a new event replaces the pending one
+    COALESCE_MERGE,                 // a new event is merged into the pending one (for instance: sum of deltas)
+};
+
+
+//===================================================================
+// a base of event channel: the manager dispatches channels
+// without knowing about their event types
+//===================================================================
+class IEventChannel
+{
+public:
+    virtual ~IEventChannel() {}
+    virtual void DrainPosted() = 0;
+    virtual void DiscardPostedAfter(const uint64_t orderKey) = 0;
+    virtual void Dispatch() = 0;
+    virtual void Clear() = 0;
+};
+
+//===================================================================
+// a channel for events of particular type
+//===================================================================
+template <typename T>
+class EventChannel : public IEventChannel
 {
 public:
-    inline void AddEvent(Event event)
+    // a handler is called with user's data ptr (for instance: ptr to Game)
+    using Handler = void (*)(void* pUserData, const T& e);
+
+    // merges a new event into the pending one (for COALESCE_MERGE)
+    using Merger  = void (*)(T& pending, const T& e);
+
+    EventChannel() { m_DrainBuf.reserve(EVENT_QUEUE_CAPACITY); }
+
+    //-----------------------------------------------------
+    // Desc:  push an event into the ring buffer; if the buffer
+    //        is full the event is dropped; if there is a pending
+    //        event for the same entity it can be coalesced with it
+    //-----------------------------------------------------
+    inline void Push(const T& e)
+    {
+        CoalesceEntry* pEntry = nullptr;
+
+        if (m_Policy != COALESCE_NONE)
+        {
+            pEntry = FindCoalesceEntry(e.id);
+
+            if (pEntry->gen == m_CoalesceGen)
+            {
+                T& pending = m_Events[pEntry->pos & (EVENT_QUEUE_CAPACITY-1)];
+
+                if (m_Policy == COALESCE_MERGE)
+                    m_Merge(pending, e);
+                else
+                    pending = e;
+
+                return;
+            }
+        }
+
+        if (m_Tail - m_Head >= EVENT_QUEUE_CAPACITY)
+        {
+            LogErr(LOG, "event queue (type: %d) is full, the event is dropped", (int)T::TYPE);
+            return;
+        }
+
+        // remember where the pending event of this entity is
+        if (pEntry)
+            *pEntry = { e.id, m_Tail, m_CoalesceGen };
+
+        m_Events[m_Tail & (EVENT_QUEUE_CAPACITY-1)] = e;
+        m_Tail++;
+    }
+
+    //-----------------------------------------------------
+    // Desc:  post an event from any thread; it gets into the ring buffer
+    //        only when the main thread drains posted events
+    // Args:  - e:         an event to post
+    //        - orderKey:  defines the order of draining (see MakeEventOrderKey)
+    //-----------------------------------------------------
+    inline void Post(const T& e, const uint64_t orderKey)
+    {
+        // drops are only counted here and reported once by DrainPosted:
+        // a full queue would flood the log with a message per event
+        if (!m_Posted.Push({ orderKey, e }))
+            m_NumDroppedPosts.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    //-----------------------------------------------------
+    // Desc:  posted events with keys greater than the input one won't get
+    //        into the ring buffer by the next draining (for instance: the rest
+    //        of contacts after the one which stops the processing); is called
+    //        only by the main thread when there are no posters
+    //-----------------------------------------------------
+    virtual void DiscardPostedAfter(const uint64_t orderKey) override
+    {
+        if (orderKey < m_PostedCutoff)
+            m_PostedCutoff = orderKey;
+    }
+
+    //-----------------------------------------------------
+    // Desc:  move posted events into the ring buffer sorted by their keys
+    //        (is called only by the main thread when there are no posters)
+    //-----------------------------------------------------
+    virtual void DrainPosted() override
+    {
+        PostedEvent posted;
+
+        while (m_Posted.Pop(posted))
+            m_DrainBuf.push_back(posted);
+
+        const int numDropped = m_NumDroppedPosts.exchange(0, std::memory_order_relaxed);
+
+        if (numDropped > 0)
+            LogErr(LOG, "posted events queue (type: %d) is full, %d events are dropped", (int)T::TYPE, numDropped);
+
+        const uint64_t cutoff = m_PostedCutoff;
+        m_PostedCutoff = UINT64_MAX;
+
+        if (m_DrainBuf.empty())
+            return;
+
+        std::sort(m_DrainBuf.begin(), m_DrainBuf.end(),
+            [](const PostedEvent& a, const PostedEvent& b) { return a.key < b.key; });
+
+        for (const PostedEvent& p : m_DrainBuf)
+        {
+            // the rest is after the cutoff as well since they are sorted
+            if (p.key > cutoff)
+                break;
+
+            Push(p.e);
+        }
+
+        m_DrainBuf.clear();
+    }
+
+    //-----------------------------------------------------
+    // Desc:  setup how events of this type are coalesced
+    // Args:  - policy:  coalescing policy
+    //        - merge:   a function to merge events (only for COALESCE_MERGE)
+    //-----------------------------------------------------
+    void SetCoalescing(const eCoalescePolicy policy, Merger merge = nullptr)
     {
-        m_Events.push_back(event);
+        if (policy == COALESCE_MERGE && !merge)
+        {
+            LogErr(LOG, "no merge function for event type: %d", (int)T::TYPE);
+            return;
+        }
+
+        m_Policy = policy;
+        m_Merge  = merge;
+
+        // the table is allocated only once, twice bigger than the queue
+        // so it never overflows by pending events
+        if (policy != COALESCE_NONE && m_CoalesceTable.empty())
+            m_CoalesceTable.resize(EVENT_QUEUE_CAPACITY * 2);
+
+        m_CoalesceGen++;
     }
 
+    //-----------------------------------------------------
+    // Desc:  add a handler which is called for each event of this type
+    //-----------------------------------------------------
+    void Subscribe(Handler handler, void* pUserData)
+    {
+        if (m_NumSubscribers >= MAX_EVENT_SUBSCRIBERS)
+        {
+            LogErr(LOG, "too many subscribers for event type: %d", (int)T::TYPE);
+            return;
+        }
+
+        m_Subscribers[m_NumSubscribers] = { handler, pUserData };
+        m_NumSubscribers++;
+    }
+
+    //-----------------------------------------------------
+    // Desc:  pass all the queued events to the subscribers;
+    //        events which are added during the dispatching
+    //        are left for the next dispatch
+    //-----------------------------------------------------
+    virtual void Dispatch() override
+    {
+        const uint end = m_Tail;
+
+        // events which are added during dispatching aren't coalesced with these ones
+        m_CoalesceGen++;
+
+        for (; m_Head != end; ++m_Head)
+        {
+            const T& e = m_Events[m_Head & (EVENT_QUEUE_CAPACITY-1)];
+
+            for (int i = 0; i < m_NumSubscribers; ++i)
+                m_Subscribers[i].handler(m_Subscribers[i].pUserData, e);
+        }
+    }
+
+    virtual void Clear() override
+    {
+        PostedEvent posted;
+        while (m_Posted.Pop(posted)) {}
+
+        m_PostedCutoff = UINT64_MAX;
+        m_Head = m_Tail;
+        m_CoalesceGen++;
+    }
+
+    inline uint GetNumEvents() const { return m_Tail - m_Head; }
+
+private:
+    struct Subscriber
+    {
+        Handler handler   = nullptr;
+        void*   pUserData = nullptr;
+    };
+
+    // an event which is posted from some thread
+    struct PostedEvent
+    {
+        uint64_t key = 0;
+        T        e;
+    };
+
+    // [entity ID => position of its pending event]; an entry is valid
+    // only if its generation is equal to the current one
+    struct CoalesceEntry
+    {
+        EntityID id  = 0;
+        uint     pos = 0;
+        uint     gen = 0;
+    };
+
+    //-----------------------------------------------------
+    // Desc:  find an entry of the entity or an empty entry for it
+    //        (open addressing with linear probing)
+    //-----------------------------------------------------
+    inline CoalesceEntry* FindCoalesceEntry(const EntityID id)
+    {
+        const uint mask = (uint)m_CoalesceTable.size() - 1;
+        uint       idx  = (id * 2654435761u) & mask;
+
+        while (true)
+        {
+            CoalesceEntry& entry = m_CoalesceTable[idx];
+
+            if (entry.gen != m_CoalesceGen || entry.id == id)
+                return &entry;
+
+            idx = (idx + 1) & mask;
+        }
+    }
+
+    T          m_Events[EVENT_QUEUE_CAPACITY];
+    uint       m_Head = 0;                    // read position (is wrapped by mask)
+    uint       m_Tail = 0;                    // write position
+    Subscriber m_Subscribers[MAX_EVENT_SUBSCRIBERS];
+    int        m_NumSubscribers = 0;
+
+    eCoalescePolicy            m_Policy      = COALESCE_NONE;
+    Merger                     m_Merge       = nullptr;
+    std::vector<CoalesceEntry> m_CoalesceTable;
+    uint                       m_CoalesceGen = 1;
+
+    MPSCQueue<PostedEvent, EVENT_QUEUE_CAPACITY> m_Posted;
+    std::vector<PostedEvent>                     m_DrainBuf;
+    uint64_t                                     m_PostedCutoff = UINT64_MAX;   // see DiscardPostedAfter
+    std::atomic<int>                             m_NumDroppedPosts{0};
+};
+
+//===================================================================
+
+class EventMgr
+{
 public:
-    std::deque<Event> m_Events;
+    EventMgr();
+    ~EventMgr();
+
+    template <typename T>
+    inline void AddEvent(const T& event)
+    {
+        GetChannel<T>().Push(event);
+    }
+
+    // can be called from any thread (see EventChannel::Post)
+    template <typename T>
+    inline void PostEvent(const T& event, const uint64_t orderKey)
+    {
+        GetChannel<T>().Post(event, orderKey);
+    }
+
+    // is called only by the main thread (see EventChannel::DiscardPostedAfter)
+    void DiscardPostedAfter(const uint64_t orderKey);
+
+    template <typename T>
+    inline void Subscribe(typename EventChannel<T>::Handler handler, void* pUserData)
+    {
+        GetChannel<T>().Subscribe(handler, pUserData);
+    }
+
+    template <typename T>
+    inline void SetCoalescing(
+        const eCoalescePolicy policy,
+        typename EventChannel<T>::Merger merge = nullptr)
+    {
+        GetChannel<T>().SetCoalescing(policy, merge);
+    }
+
+    template <typename T>
+    inline EventChannel<T>& GetChannel()
+    {
+        return *static_cast<EventChannel<T>*>(m_Channels[T::TYPE]);
+    }
+
+    void DrainPosted();
+    void Dispatch();
+    void Clear();
+
+private:
+    IEventChannel* m_Channels[NUM_EVENT_TYPES]{nullptr};
 };
 
 //===================================================================
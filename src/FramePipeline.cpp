@@ -0,0 +1,114 @@
+// ==================================================================
+// Filename:    FramePipeline.cpp
+// Created:     19.10.2026 by DimaSkup
+// ==================================================================
+#include "FramePipeline.h"
+#include "TraceRecorder.h"
+#include "Log.h"
+
+
+FramePipeline::~FramePipeline()
+{
+    Stop();
+}
+
+//---------------------------------------------------------
+// Desc:   start the simulation thread (it waits for StartSimulation)
+// Args:   - func:      is called by the simulation thread for each frame
+//         - pUserData: is passed into the function (for instance: the game)
+//---------------------------------------------------------
+void FramePipeline::Start(SimulateFunc func, void* pUserData)
+{
+    Stop();
+
+    m_Func      = func;
+    m_pUserData = pUserData;
+    m_HasWork   = false;
+    m_Quit      = false;
+    m_Thread    = std::thread(&FramePipeline::SimulationLoop, this);
+
+    LogMsg(LOG, "frame pipeline is started: simulation and rendering are on separate threads");
+}
+
+//---------------------------------------------------------
+// Desc:   wait for the current frame and stop the simulation thread
+//---------------------------------------------------------
+void FramePipeline::Stop()
+{
+    if (!m_Thread.joinable())
+        return;
+
+    WaitSimulation();
+
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Quit = true;
+    }
+    m_CV.notify_all();
+
+    m_Thread.join();
+}
+
+//---------------------------------------------------------
+// Desc:   let the simulation thread produce the next frame
+//         (is called by the main thread after the sync point)
+//---------------------------------------------------------
+void FramePipeline::StartSimulation()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_HasWork = true;
+    }
+    m_CV.notify_all();
+}
+
+//---------------------------------------------------------
+// Desc:   wait until the simulation of the frame is done
+//         (after it returns the simulation thread is idle)
+//---------------------------------------------------------
+void FramePipeline::WaitSimulation()
+{
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_CV.wait(lock, [this]() { return !m_HasWork; });
+}
+
+//---------------------------------------------------------
+// Desc:   the just simulated snapshot becomes the one for rendering;
+//         must be called at the sync point (the simulation is idle)
+//---------------------------------------------------------
+void FramePipeline::SwapSnapshots()
+{
+    m_SimIdx ^= 1;
+}
+
+//---------------------------------------------------------
+// Desc:   a loop of the simulation thread: wait for the start of
+//         the frame, simulate it into its snapshot and report it's done
+//---------------------------------------------------------
+void FramePipeline::SimulationLoop()
+{
+    g_TraceRecorder.SetThreadName("simulation");
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_CV.wait(lock, [this]() { return m_HasWork || m_Quit; });
+
+            if (m_Quit)
+                return;
+        }
+
+        RenderSnapshot& snapshot = m_Snapshots[m_SimIdx];
+        snapshot.Clear();
+        snapshot.frameIdx = ++m_FrameIdx;
+
+        m_Func(m_pUserData, snapshot);
+
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_HasWork = false;
+        }
+        m_CV.notify_all();
+    }
+}
@@ -0,0 +1,69 @@
+// ==================================================================
+// Filename:    FramePipeline.h
+// Description: a two-stage frame pipeline: the simulation thread
+//              produces the frame N+1 (update + render snapshot) while
+//              the main thread renders the snapshot of the frame N and
+//              presents it; the snapshots are double-buffered:
+//
+//              main:   | input N+1 | render N   + present | input N+2 | ...
+//              sim:    |           | update N+1 + extract |           | ...
+//                                                          ^ sync: swap
+//
+//              at the sync point the simulation thread is idle, so the main
+//              thread can safely touch the simulation state (input, UI text)
+//
+// Created:     19.10.2026 by DimaSkup
+// ==================================================================
+#ifndef FRAME_PIPELINE_H
+#define FRAME_PIPELINE_H
+
+#include "RenderSnapshot.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+// simulates the next frame and fills its render snapshot (on the simulation thread)
+using SimulateFunc = void(*)(void* pUserData, RenderSnapshot& outSnapshot);
+
+class FramePipeline
+{
+public:
+    FramePipeline() {}
+    ~FramePipeline();
+
+    void Start(SimulateFunc func, void* pUserData);
+    void Stop();
+
+    void StartSimulation();
+    void WaitSimulation();
+    void SwapSnapshots();
+
+    // is written by the simulation (only at the sync point by main thread)
+    inline RenderSnapshot&       GetSimSnapshot()          { return m_Snapshots[m_SimIdx]; }
+
+    // is read by the main thread for rendering
+    inline const RenderSnapshot& GetRenderSnapshot() const { return m_Snapshots[m_SimIdx ^ 1]; }
+
+    // an index of the frame which is simulated by the next StartSimulation
+    // (is read by the main thread only at the sync point)
+    inline uint32_t              GetNextFrameIdx()   const { return m_FrameIdx + 1; }
+
+private:
+    void SimulationLoop();
+
+private:
+    std::thread             m_Thread;
+    std::mutex              m_Mutex;
+    std::condition_variable m_CV;
+    bool                    m_HasWork   = false;    // the next frame must be simulated
+    bool                    m_Quit      = false;
+
+    SimulateFunc            m_Func      = nullptr;
+    void*                   m_pUserData = nullptr;
+
+    RenderSnapshot          m_Snapshots[2];
+    int                     m_SimIdx    = 0;
+    uint32_t                m_FrameIdx  = 0;
+};
+
+#endif
@@ -0,0 +1,236 @@
+// ==================================================================
+// Filename:    FrameStats.cpp
+// Created:     19.10.2026 by DimaSkup
+// ==================================================================
+#include "FrameStats.h"
+#include "Profiler.h"
+#include "Log.h"
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <stdio.h>
+
+// init a global instance of the frame stats
+FrameStats g_FrameStats;
+
+
+///////////////////////////////////////////////////////////
+
+FrameStats::FrameStats()
+{
+    m_Hitches.reserve(FRAME_STATS_MAX_HITCHES);
+}
+
+//---------------------------------------------------------
+// Desc:   store time of each frame so percentiles of the whole run
+//         are exact instead of the histogram bins (for short benchmark runs)
+//---------------------------------------------------------
+void FrameStats::KeepAllFrames(const uint32_t numFramesToReserve)
+{
+    m_KeepAllFrames = true;
+    m_AllFrames.reserve(numFramesToReserve);
+}
+
+//---------------------------------------------------------
+// Desc:   measure time of the frame which is just finished
+//         (is called once per frame after the profiler's EndFrame)
+//---------------------------------------------------------
+void FrameStats::EndFrame()
+{
+    const uint64_t now = SDL_GetPerformanceCounter();
+
+    // the first call only starts measuring
+    if (m_PrevTicks == 0)
+    {
+        m_MsPerTick = 1000.0 / (double)SDL_GetPerformanceFrequency();
+        m_PrevTicks = now;
+        return;
+    }
+
+    const float frameMs = (float)((now - m_PrevTicks) * m_MsPerTick);
+    m_PrevTicks = now;
+
+    AddFrame(frameMs);
+}
+
+//---------------------------------------------------------
+// Desc:   add frame time into the window and histogram, detect a hitch
+//---------------------------------------------------------
+void FrameStats::AddFrame(const float frameMs)
+{
+    int bin = (int)(frameMs / FRAME_STATS_BIN_MS);
+    bin     = (bin < FRAME_STATS_NUM_BINS) ? bin : FRAME_STATS_NUM_BINS-1;
+
+    m_Histogram[bin]++;
+    m_MaxMs = (frameMs > m_MaxMs) ? frameMs : m_MaxMs;
+    m_TotalMs += frameMs;
+
+    if (m_KeepAllFrames)
+        m_AllFrames.push_back(frameMs);
+
+    if (frameMs > m_BudgetMs)
+    {
+        Hitch hitch;
+        hitch.frameIdx = m_NumFrames;
+        hitch.frameMs  = frameMs;
+        hitch.phase    = g_Profiler.GetSlowestPhase(hitch.phaseMs);
+
+        if (!hitch.phase)
+            hitch.phase = "unknown";
+
+        LogMsg(LOG, "hitch: frame %u took %.2f ms (budget %.2f ms), the slowest phase: %s (%.2f ms)",
+            hitch.frameIdx, hitch.frameMs, m_BudgetMs, hitch.phase, hitch.phaseMs);
+
+        if (m_Hitches.size() < FRAME_STATS_MAX_HITCHES)
+            m_Hitches.push_back(hitch);
+
+        m_NumHitches++;
+        m_WindowHitches++;
+    }
+
+    m_Window[m_WindowSize++] = frameMs;
+    m_NumFrames++;
+
+    if (m_WindowSize == FRAME_STATS_WINDOW_FRAMES)
+        ComputeWindow();
+}
+
+//---------------------------------------------------------
+// Desc:   compute exact percentiles of the finished window
+//---------------------------------------------------------
+void FrameStats::ComputeWindow()
+{
+    const int n = m_WindowSize;
+
+    if (n == 0)
+        return;
+
+    std::copy(m_Window, m_Window + n, m_SortBuf);
+
+    // nearest-rank percentile
+    auto percentile = [this, n](const int p)
+    {
+        const int k = std::min(n-1, (p * n + 99) / 100 - 1);
+        std::nth_element(m_SortBuf, m_SortBuf + k, m_SortBuf + n);
+        return m_SortBuf[k];
+    };
+
+    FrameTimeStats& stats = m_LastWindow;
+    float           sum   = 0;
+
+    for (int i = 0; i < n; ++i)
+        sum += m_Window[i];
+
+    stats.firstFrame = m_NumFrames - n;
+    stats.numFrames  = n;
+    stats.numHitches = m_WindowHitches;
+    stats.avgMs      = sum / n;
+    stats.p50Ms      = percentile(50);
+    stats.p95Ms      = percentile(95);
+    stats.p99Ms      = percentile(99);
+    stats.maxMs      = *std::max_element(m_Window, m_Window + n);
+
+    m_Windows.push_back(stats);
+
+    m_WindowSize    = 0;
+    m_WindowHitches = 0;
+}
+
+//---------------------------------------------------------
+// Desc:   get percentiles over the whole run (accuracy is a bin width
+//         if we don't keep all the frames)
+//---------------------------------------------------------
+void FrameStats::GetTotalStats(FrameTimeStats& outStats) const
+{
+    outStats            = FrameTimeStats();
+    outStats.numFrames  = m_NumFrames;
+    outStats.numHitches = m_NumHitches;
+    outStats.maxMs      = m_MaxMs;
+
+    if (m_NumFrames == 0)
+        return;
+
+    outStats.avgMs = (float)(m_TotalMs / m_NumFrames);
+
+    if (m_KeepAllFrames)
+    {
+        std::vector<float> sorted(m_AllFrames);
+        std::sort(sorted.begin(), sorted.end());
+
+        const uint32_t n = (uint32_t)sorted.size();
+        outStats.p50Ms   = sorted[std::min(n-1, (50 * n + 99) / 100 - 1)];
+        outStats.p95Ms   = sorted[std::min(n-1, (95 * n + 99) / 100 - 1)];
+        outStats.p99Ms   = sorted[std::min(n-1, (99 * n + 99) / 100 - 1)];
+        return;
+    }
+
+    // the upper bound of the bin where the percentile is
+    const uint32_t rank50 = (50 * m_NumFrames + 99) / 100;
+    const uint32_t rank95 = (95 * m_NumFrames + 99) / 100;
+    const uint32_t rank99 = (99 * m_NumFrames + 99) / 100;
+    uint32_t       count  = 0;
+
+    for (int i = 0; i < FRAME_STATS_NUM_BINS; ++i)
+    {
+        const uint32_t prev  = count;
+        const float    binMs = std::min((i + 1) * FRAME_STATS_BIN_MS, m_MaxMs);
+
+        count += m_Histogram[i];
+
+        if (prev < rank50 && count >= rank50) outStats.p50Ms = binMs;
+        if (prev < rank95 && count >= rank95) outStats.p95Ms = binMs;
+        if (prev < rank99 && count >= rank99) outStats.p99Ms = binMs;
+    }
+}
+
+//---------------------------------------------------------
+// Desc:   log the summary of the run and write the CSV file (if it is set)
+//         (is called once at shutdown)
+//---------------------------------------------------------
+void FrameStats::Report()
+{
+    // stats of the unfinished window
+    ComputeWindow();
+
+    FrameTimeStats total;
+    GetTotalStats(total);
+
+    LogMsg(LOG, "frame time: frames %u, avg %.2f ms, p50 %.2f ms, p95 %.2f ms, p99 %.2f ms, max %.2f ms",
+        total.numFrames, total.avgMs, total.p50Ms, total.p95Ms, total.p99Ms, total.maxMs);
+
+    LogMsg(LOG, "hitches (longer than %.2f ms): %u", m_BudgetMs, total.numHitches);
+
+    if (!m_CsvFilename.empty())
+        WriteCsv(m_CsvFilename.c_str());
+}
+
+//---------------------------------------------------------
+// Desc:   write stats of each window and each hitch into a CSV file
+//---------------------------------------------------------
+bool FrameStats::WriteCsv(const char* filename) const
+{
+    FILE* pFile = fopen(filename, "w");
+    if (!pFile)
+    {
+        LogErr(LOG, "can't open a file for frame stats: %s", filename);
+        return false;
+    }
+
+    fprintf(pFile, "type,first_frame,num_frames,hitches,p50_ms,p95_ms,p99_ms,max_ms,phase,phase_ms\n");
+
+    for (const FrameTimeStats& w : m_Windows)
+    {
+        fprintf(pFile, "window,%u,%u,%u,%.3f,%.3f,%.3f,%.3f,,\n",
+            w.firstFrame, w.numFrames, w.numHitches, w.p50Ms, w.p95Ms, w.p99Ms, w.maxMs);
+    }
+
+    for (const Hitch& h : m_Hitches)
+    {
+        fprintf(pFile, "hitch,%u,1,1,,,,%.3f,%s,%.3f\n",
+            h.frameIdx, h.frameMs, h.phase, h.phaseMs);
+    }
+
+    fclose(pFile);
+
+    LogMsg(LOG, "frame stats are written: %s", filename);
+    return true;
+}
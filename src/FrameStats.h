@@ -0,0 +1,106 @@
+// ==================================================================
+// Filename:    FrameStats.h
+// Description: frame time statistics which show stutters
+//              (FPS per second hides single long frames):
+//              - frame time is measured from the end of one frame
+//                to the end of the next one
+//              - p50/p95/p99/max are computed over rolling windows
+//                of frames and over the whole run (by a histogram)
+//              - a frame longer than the budget is a hitch: it is logged
+//                with the slowest top-level profiler zone (a frame phase)
+//              - at shutdown the summary is logged and optionally
+//                the stats of all the windows are written into a CSV file
+//
+// Created:     19.10.2026 by DimaSkup
+// ==================================================================
+#ifndef FRAME_STATS_H
+#define FRAME_STATS_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+constexpr int   FRAME_STATS_WINDOW_FRAMES = 300;     // frames in a rolling window
+constexpr float FRAME_STATS_BIN_MS        = 0.1f;    // a width of histogram bin
+constexpr int   FRAME_STATS_NUM_BINS      = 2000;    // up to 200 ms (the last bin holds all the longer)
+constexpr int   FRAME_STATS_MAX_HITCHES   = 1024;    // max num of hitches kept for the report
+
+// percentiles of frame time (in milliseconds)
+struct FrameTimeStats
+{
+    uint32_t firstFrame = 0;
+    uint32_t numFrames  = 0;
+    uint32_t numHitches = 0;
+    float    avgMs      = 0;
+    float    p50Ms      = 0;
+    float    p95Ms      = 0;
+    float    p99Ms      = 0;
+    float    maxMs      = 0;
+};
+
+class FrameStats
+{
+public:
+    FrameStats();
+
+    void EndFrame();
+
+    inline void SetBudgetMs(const float budgetMs)     { m_BudgetMs = budgetMs; }
+    inline void SetCsvFilename(const char* filename)  { m_CsvFilename = filename; }
+
+    void KeepAllFrames(const uint32_t numFramesToReserve);
+
+    inline float                 GetBudgetMs()   const { return m_BudgetMs; }
+    inline const FrameTimeStats& GetLastWindow() const { return m_LastWindow; }
+
+    void GetTotalStats(FrameTimeStats& outStats) const;
+    void Report();
+
+private:
+    struct Hitch
+    {
+        uint32_t    frameIdx = 0;
+        float       frameMs  = 0;
+        const char* phase    = nullptr;   // the slowest top-level zone
+        float       phaseMs  = 0;
+    };
+
+    void AddFrame(const float frameMs);
+    void ComputeWindow();
+    bool WriteCsv(const char* filename) const;
+
+private:
+    float       m_BudgetMs    = 33.3f;
+    std::string m_CsvFilename;
+
+    uint64_t    m_PrevTicks   = 0;
+    double      m_MsPerTick   = 0;
+    uint32_t    m_NumFrames   = 0;
+    uint32_t    m_NumHitches  = 0;
+    float       m_MaxMs       = 0;
+    double      m_TotalMs     = 0;
+
+    // times of all the frames for exact percentiles of the whole run (benchmarks)
+    bool               m_KeepAllFrames = false;
+    std::vector<float> m_AllFrames;
+
+    // the current window: frame times are copied for exact percentiles
+    float       m_Window[FRAME_STATS_WINDOW_FRAMES]{0};
+    float       m_SortBuf[FRAME_STATS_WINDOW_FRAMES]{0};
+    int         m_WindowSize    = 0;
+    uint32_t    m_WindowHitches = 0;
+
+    FrameTimeStats              m_LastWindow;
+    std::vector<FrameTimeStats> m_Windows;       // all the finished windows (for the CSV)
+    std::vector<Hitch>          m_Hitches;
+
+    // the whole run: percentiles are taken from the histogram
+    uint32_t    m_Histogram[FRAME_STATS_NUM_BINS]{0};
+};
+
+// ==================================================================
+// Declare a global instance of the frame stats
+// ==================================================================
+extern FrameStats g_FrameStats;
+
+#endif
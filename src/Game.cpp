@@ -18,19 +18,31 @@
 #include "Components/LifeTimer.h"
 #include "GameState.h"
 #include "EventMgr.h"
+#include "JobSystem.h"
+#include "TimerWheel.h"
+#include "InputMgr.h"
+#include "InputRecorder.h"
+#include "Profiler.h"
+#include "TraceRecorder.h"
+#include "FrameStats.h"
+#include "SoundMgr.h"
+#include <stdarg.h>
 
 #define SHOW_DBG_INFO_WHEN_CREATE_ENTITIES 0
 
 // init Game's static members 
-SDL_Event Game::ms_Event;
-SDL_Rect  Game::ms_Camera = {0, 0, WINDOW_WIDTH, WINDOW_HEIGHT};
+SDL_Rect   Game::ms_Camera = {0, 0, WINDOW_WIDTH, WINDOW_HEIGHT};
+InputFrame Game::ms_Input;
+
+// a timestep which is used for input recording if no other is set
+constexpr uint32_t DEFAULT_FIXED_DELTA_MS = 16;
+
+// num of frames in the headless mode if no other is set
+constexpr uint32_t DEFAULT_BENCH_FRAMES = 1000;
 
 const SDL_Color WHITE_COLOR = { 255, 255, 255, 255 };
 const SDL_Color GREEN_COLOR = { 0, 255, 0, 255 };
 
-// static pointer to the tilemap
-Map* s_pMap = nullptr;
-
 // init some globals
 GameStates g_GameStates;
 
@@ -46,10 +58,116 @@ Game::Game() : m_Running(false)
 
 Game::~Game()
 {
+    g_JobSystem.Shutdown();
     g_AssetMgr.ClearData(); 
     
-    if (s_pMap)
-        delete s_pMap;
+    if (g_pMap)
+        delete g_pMap;
+}
+
+//---------------------------------------------------------
+// Desc:   setup the game by command line args:
+//         --record=<file>   record input into the file
+//         --replay=<file>   replay input from the file
+//         --fixed-dt=<ms>   run the simulation with a fixed timestep
+//         --trace-seconds=<sec>   how many last seconds of the trace to dump
+//         --trace-on-exit=<file>  dump the trace into the file on exit
+//         --frame-budget=<ms>     a frame longer than this is logged as a hitch
+//         --frame-stats=<file>    write frame time stats into a CSV file on exit
+//         --headless              no real window/audio, no help screen (benchmarks on CI)
+//         --frames=<N>            stop after N frames
+//         --scene=<N>             a number of the level to load
+//         --bench-out=<file>      write benchmark results (JSON) into the file
+//                                 (by default: benchmark.json)
+//         --stress=<N>,<M>,<W>x<H>[,seed]
+//                                 add N enemies and M obstacles to the scene
+//                                 and generate a tilemap of WxH tiles
+//         --log-level=<levels>    levels of log messages: a list of <level> or
+//                                 <category>:<level> (debug, msg, err, none),
+//                                 for instance: --log-level=msg,Render:debug
+//         --log-binary=<file>     write log messages into a binary file
+//                                 (decode it with the log_decoder tool)
+//         --no-pipeline           simulate and render each frame on the main
+//                                 thread one after another (see FramePipeline)
+//---------------------------------------------------------
+void Game::ParseCommandLine(int argc, char* argv[])
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* arg = argv[i];
+
+        if (strncmp(arg, "--record=", 9) == 0)
+            m_RecordFilename = arg + 9;
+
+        else if (strncmp(arg, "--replay=", 9) == 0)
+            m_ReplayFilename = arg + 9;
+
+        else if (strncmp(arg, "--fixed-dt=", 11) == 0)
+            m_FixedDeltaMs = (uint32_t)atoi(arg + 11);
+
+        else if (strncmp(arg, "--trace-seconds=", 16) == 0)
+            m_TraceSeconds = (float)atof(arg + 16);
+
+        else if (strncmp(arg, "--trace-on-exit=", 16) == 0)
+            m_TraceExitFilename = arg + 16;
+
+        else if (strncmp(arg, "--frame-budget=", 15) == 0)
+            g_FrameStats.SetBudgetMs((float)atof(arg + 15));
+
+        else if (strncmp(arg, "--frame-stats=", 14) == 0)
+            g_FrameStats.SetCsvFilename(arg + 14);
+
+        else if (strcmp(arg, "--headless") == 0)
+            m_IsHeadless = true;
+
+        else if (strncmp(arg, "--frames=", 9) == 0)
+            m_NumBenchFrames = (uint32_t)atoi(arg + 9);
+
+        else if (strncmp(arg, "--scene=", 8) == 0)
+            m_SceneLevel = atoi(arg + 8);
+
+        else if (strncmp(arg, "--bench-out=", 12) == 0)
+            m_BenchOutFilename = arg + 12;
+
+        else if (strncmp(arg, "--stress=", 9) == 0)
+        {
+            StressSceneParams& s = m_Stress;
+
+            if (sscanf(arg + 9, "%d,%d,%dx%d,%u", &s.numEnemies, &s.numObstacles, &s.mapSizeX, &s.mapSizeY, &s.seed) < 4)
+            {
+                LogErr(LOG, "invalid stress scene (expected: <N>,<M>,<W>x<H>[,seed]): %s", arg);
+                m_Stress = StressSceneParams();
+            }
+        }
+
+        else if (strncmp(arg, "--log-level=", 12) == 0)
+        {
+            if (!SetLogLevels(arg + 12))
+                LogErr(LOG, "invalid log levels (expected: <level> or <category>:<level>, ...): %s", arg);
+        }
+
+        else if (strncmp(arg, "--log-binary=", 13) == 0)
+            SetLogBinaryFile(arg + 13);
+
+        else if (strcmp(arg, "--no-pipeline") == 0)
+            m_IsPipelined = false;
+
+        else
+            LogErr(LOG, "unknown command line argument: %s", arg);
+    }
+
+    // a benchmark must be repeatable: fixed timestep and num of frames
+    if (m_IsHeadless)
+    {
+        if (m_FixedDeltaMs == 0)
+            m_FixedDeltaMs = DEFAULT_FIXED_DELTA_MS;
+
+        if (m_NumBenchFrames == 0)
+            m_NumBenchFrames = DEFAULT_BENCH_FRAMES;
+
+        m_ShowHelpScreen = false;
+        g_FrameStats.KeepAllFrames(m_NumBenchFrames);
+    }
 }
 
 //---------------------------------------------------------
@@ -57,7 +175,19 @@ Game::~Game()
 //---------------------------------------------------------
 void Game::Initialize()
 {
-    LoadLevel(1);
+    // start worker threads (num of cores minus the main thread)
+    g_JobSystem.Initialize();
+
+    // (after the render so SDL already uses the chosen audio driver)
+    if (g_SoundMgr.Initialize() == -1)
+    {
+        LogErr(LOG, "can't initialize the sound manager");
+        exit(-1);
+    }
+
+    SubscribeToEvents();
+
+    LoadLevel(m_SceneLevel);
 
     m_PrevTicks = SDL_GetTicks();
 
@@ -136,43 +266,92 @@ void Game::Initialize()
     lifeSprite2.AddComponent<Sprite>("chopper-texture", spriteParams);
     lifeSprite3.AddComponent<Sprite>("chopper-texture", spriteParams);
 
+    StartInputRecorder();
+
     LogMsg(LOG, "The game is initialized!");
 }
 
 //---------------------------------------------------------
-// Desc:   process input from the devices
+// Desc:   start recording or replaying of input if it was requested;
+//         both of them require a fixed timestep to be deterministic
 //---------------------------------------------------------
-void Game::ProcessInput()
+void Game::StartInputRecorder()
+{
+    if (!m_ReplayFilename.empty())
+    {
+        if (g_InputRecorder.StartReplay(m_ReplayFilename.c_str()))
+            m_FixedDeltaMs = g_InputRecorder.GetFixedDeltaMs();
+    }
+    else if (!m_RecordFilename.empty())
+    {
+        if (m_FixedDeltaMs == 0)
+            m_FixedDeltaMs = DEFAULT_FIXED_DELTA_MS;
+
+        g_InputRecorder.StartRecording(m_RecordFilename.c_str(), m_FixedDeltaMs);
+    }
+}
+
+//---------------------------------------------------------
+// Desc:   get input of the current frame from the devices, or from
+//         the recording if we replay it (in this case the devices can
+//         only stop the game)
+//---------------------------------------------------------
+void Game::PollInput()
 {
-    SDL_PollEvent(&ms_Event);
+    g_InputMgr.PollEvents();
 
-    switch (ms_Event.type)
+    if (g_InputRecorder.IsReplaying())
     {
-        case SDL_QUIT:
+        if (g_InputMgr.GetFrame().IsPressed(INPUT_ACTION_EXIT))
+            m_Running = false;
+
+        if (!g_InputRecorder.ReplayFrame(ms_Input))
         {
+            g_InputRecorder.Stop();
             m_Running = false;
-            break;
+            ms_Input  = InputFrame();
         }
-        case SDL_KEYDOWN:
-        {
-            const SDL_Keycode key = ms_Event.key.keysym.sym;
+        return;
+    }
 
-            if      (key == SDLK_ESCAPE)  m_Running = false;          // shutdown and exit from the game
-            else if (key == SDLK_F2)      m_ShowAABB = !m_ShowAABB;   // switch on/off the visualization of the AABB
-            else if (key == SDLK_RETURN)  m_ShowHelpScreen = false;
-            
-            else if (key == SDLK_SPACE)   
-            {
-                const EntityID id = g_EntityMgr.GetPlayer()->GetID();
-                g_EventMgr.AddEvent(EventPlayerShoot(id));
-            }
+    ms_Input = g_InputMgr.GetFrame();
+    g_InputRecorder.RecordFrame(ms_Input);
+}
 
-            break;
-        }
-        default:
-        {
-            break;
-        }
+//---------------------------------------------------------
+// Desc:   process input from the devices
+//---------------------------------------------------------
+void Game::ProcessInput()
+{
+    PollInput();
+
+    // shutdown and exit from the game
+    if (ms_Input.IsPressed(INPUT_ACTION_EXIT))
+        m_Running = false;
+
+    // switch on/off the visualization of the AABB
+    if (ms_Input.IsPressed(INPUT_ACTION_TOGGLE_AABB))
+        m_ShowAABB = !m_ShowAABB;
+
+    // switch on/off the profiler overlay
+    if (ms_Input.IsPressed(INPUT_ACTION_TOGGLE_PROFILER))
+        g_Profiler.ToggleOverlay();
+
+    // dump the last seconds of the trace
+    if (ms_Input.IsPressed(INPUT_ACTION_DUMP_TRACE))
+    {
+        char filename[64];
+        snprintf(filename, sizeof(filename), "dude_trace_%u.json", SDL_GetTicks());
+        DumpTrace(filename);
+    }
+
+    if (ms_Input.IsPressed(INPUT_ACTION_CONFIRM))
+        m_ShowHelpScreen = false;
+
+    if (ms_Input.IsPressed(INPUT_ACTION_SHOOT))
+    {
+        const EntityID id = g_EntityMgr.GetPlayer()->GetID();
+        g_EventMgr.AddEvent(EventPlayerShoot(id));
     }
 }
 
@@ -181,7 +360,8 @@ void Game::ProcessInput()
 //---------------------------------------------------------
 void Game::Update()
 {
-    if (m_ShowHelpScreen)
+    // the game is stopped: don't simulate one more frame
+    if (!m_Running || m_ShowHelpScreen)
         return;
 
     if (m_PlayerIsKilled)
@@ -193,8 +373,10 @@ void Game::Update()
     }
 
     // difference in ticks from last frame converted to seconds
+    // (the simulation uses a fixed timestep if it is set)
     const uint32_t ticksNow     = SDL_GetTicks();
-    const uint32_t deltaTimeMs  = (ticksNow - m_PrevTicks);
+    const uint32_t realDeltaMs  = (ticksNow - m_PrevTicks);
+    const uint32_t deltaTimeMs  = (m_FixedDeltaMs > 0) ? m_FixedDeltaMs : realDeltaMs;
     const float    deltaTimeSec = (float)deltaTimeMs * 0.001f; 
 
     // clamp deltaTime to a maximum value
@@ -203,7 +385,7 @@ void Game::Update()
     // set the new ticks count for the current frame to be used in the next pass
     m_PrevTicks = ticksNow;
 
-    m_TimeMs += deltaTimeMs;
+    m_TimeMs += realDeltaMs;
     m_NumDrawnFrames++;
 
     // compute actual fps value if need
@@ -214,13 +396,72 @@ void Game::Update()
         m_NumDrawnFrames = 0;
     }
  
-    HandleEvents();
-    g_EntityMgr.Update(deltaTimeSec);
+    {
+        PROFILE_ZONE("HandleEvents");
+        HandleEvents();
+    }
+    {
+        PROFILE_ZONE("TimerWheel::Advance");
+        g_TimerWheel.Advance(deltaTimeMs);
+    }
+    {
+        PROFILE_ZONE("EntityMgr::Update");
+        g_EntityMgr.Update(deltaTimeSec);
+    }
 
     HandleCameraMovement();
-    CheckCollisions();
 
-    UpdateUIText(deltaTimeMs);
+    {
+        PROFILE_ZONE("CheckCollisions");
+        CheckCollisions();
+    }
+
+    // so a replay can be compared with its recording
+    if (g_InputRecorder.IsActive())
+        g_InputRecorder.AddStateHash(ComputeStateHash());
+
+    // UI text is updated by the main thread (see UpdateUI)
+    m_RealDeltaMs = realDeltaMs;
+    m_HasNewFrame = true;
+
+    // the benchmark is over: the current frame is still rendered
+    if (m_NumBenchFrames > 0 && ++m_NumFramesDone >= m_NumBenchFrames)
+        m_Running = false;
+}
+
+//---------------------------------------------------------
+// Desc:   compute a hash of the simulation state
+//         (IDs, positions and velocities of entities)
+//---------------------------------------------------------
+uint64_t Game::ComputeStateHash() const
+{
+    uint64_t hash = 14695981039346656037ULL;
+
+    auto hashBytes = [&hash](const void* pData, const size_t size)
+    {
+        const uint8_t* bytes = (const uint8_t*)pData;
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= 1099511628211ULL;
+        }
+    };
+
+    for (Entity* pEntt : g_EntityMgr.GetEntts())
+    {
+        const EntityID id = pEntt->GetID();
+        hashBytes(&id, sizeof(id));
+
+        if (!pEntt->HasComponent<Transform>())
+            continue;
+
+        const Transform* pTransform = pEntt->GetComponent<Transform>();
+        hashBytes(&pTransform->m_Position, sizeof(pTransform->m_Position));
+        hashBytes(&pTransform->m_Velocity, sizeof(pTransform->m_Velocity));
+    }
+
+    return hash;
 }
 
 //---------------------------------------------------------
@@ -231,10 +472,11 @@ void Game::UpdateUIText(const uint32_t dtMs)
     Entity* pFpsCount  = g_EntityMgr.GetEnttByName("fps");
     Entity* pDeltaTime = g_EntityMgr.GetEnttByName("delta time");
 
-    char fpsBuf[32]{'\0'};
+    char fpsBuf[48]{'\0'};
     char deltaTimeBuf[32]{'\0'};
 
-    sprintf(fpsBuf, "Fps: %d", (int)m_FpsValue);
+    // the average hides stutters so show the slowest frames as well
+    sprintf(fpsBuf, "Fps: %d (p99: %.1f ms)", (int)m_FpsValue, g_FrameStats.GetLastWindow().p99Ms);
     sprintf(deltaTimeBuf, "Delta time: %d ms", (int)dtMs);
 
     pFpsCount->GetComponent<TextLabel>()->SetLabelText(fpsBuf, "charriot-font");
@@ -246,92 +488,128 @@ void Game::UpdateUIText(const uint32_t dtMs)
 //---------------------------------------------------------
 void Game::HandleEvents()
 {
-    for (const Event& e : g_EventMgr.m_Events)
-    {
-        Entity* pEntt = g_EntityMgr.GetEnttByID(e.id);
+    g_EventMgr.Dispatch();
+}
 
-        switch (e.type)
-        {
-            case EVENT_TYPE_SWITCH_ANIMATION:
-            {
-                eAnimationType animType = eAnimationType((int)e.x);
-                pEntt->GetComponent<Sprite>()->Play(animType);
-                break;
-            }
-            case EVENT_TYPE_PLAYER_SHOOT:
-            {
-                Entity* pPlayer = g_EntityMgr.GetPlayer();
-                HandleEventPlayerShoot(*pPlayer);
-                break;
-            }
-            case EVENT_TYPE_PLAYER_MOVE:
-            {
-                pEntt->GetComponent<Transform>()->SetVelocity(e.x, e.y);
-                break;
-            }
-            case EVENT_TYPE_PLAYER_STOP:
-            {
-                pEntt->GetComponent<Transform>()->SetVelocity(0,0);
-                break;
-            }
-            case EVENT_TYPE_PLAYER_HIT_ENEMY_PROJECTILE:
-            {
-                char name[16]{'\0'};
-                sprintf(name, "%s%d", "life_", m_NumLifes);
+//---------------------------------------------------------
+// Desc:  bind the game's handlers to the event types
+//        and setup how the events are coalesced
+//---------------------------------------------------------
+void Game::SubscribeToEvents()
+{
+    g_EventMgr.Subscribe<EventSwitchAnimation>         (OnSwitchAnimation, this);
+    g_EventMgr.Subscribe<EventPlayerShoot>             (OnPlayerShoot,     this);
+    g_EventMgr.Subscribe<EventPlayerMove>              (OnPlayerMove,      this);
+    g_EventMgr.Subscribe<EventPlayerStop>              (OnPlayerStop,      this);
+    g_EventMgr.Subscribe<EventPlayerHitEnemyProjectile>(OnPlayerHit,       this);
+    g_EventMgr.Subscribe<EventDestroyEntity>           (OnDestroyEntity,   this);
+    g_EventMgr.Subscribe<EventKillEnemy>               (OnKillEnemy,       this);
+
+    // input and collisions can emit the same event for the same entity
+    // several times per frame, but only the last one makes sense
+    g_EventMgr.SetCoalescing<EventSwitchAnimation>         (COALESCE_LAST_WRITER_WINS);
+    g_EventMgr.SetCoalescing<EventPlayerMove>              (COALESCE_LAST_WRITER_WINS);
+    g_EventMgr.SetCoalescing<EventPlayerStop>              (COALESCE_LAST_WRITER_WINS);
+    g_EventMgr.SetCoalescing<EventPlayerHitEnemyProjectile>(COALESCE_LAST_WRITER_WINS);
+    g_EventMgr.SetCoalescing<EventDestroyEntity>           (COALESCE_LAST_WRITER_WINS);
+    g_EventMgr.SetCoalescing<EventKillEnemy>               (COALESCE_LAST_WRITER_WINS);
+}
 
-                Entity* pEntt = g_EntityMgr.GetEnttByName(name);
-                if (pEntt)
-                {
-                    g_EntityMgr.DestroyEntt(pEntt->GetID());
-                }
+///////////////////////////////////////////////////////////
 
-                m_NumLifes--;
-                g_EntityMgr.DestroyEntt(e.id);
+void Game::OnSwitchAnimation(void* pGame, const EventSwitchAnimation& e)
+{
+    Entity* pEntt = g_EntityMgr.GetEnttByID(e.id);
+    if (pEntt)
+        pEntt->GetComponent<Sprite>()->Play(e.animType);
+}
 
-                if (m_NumLifes == 0)
-                    m_PlayerIsKilled = true;
+///////////////////////////////////////////////////////////
 
-                break;
-            }
-            case EVENT_TYPE_DESTROY_ENTITY:
-            {
-                g_EntityMgr.DestroyEntt(e.id);
-                break;
-            }
-            case EVENT_TYPE_KILL_ENEMY:
-            {
-                Entity* pEnemyEntt = pEntt;
+void Game::OnPlayerShoot(void* pGame, const EventPlayerShoot& e)
+{
+    Entity* pPlayer = g_EntityMgr.GetPlayer();
+    ((Game*)pGame)->HandleEventPlayerShoot(*pPlayer);
+}
 
-                PlaySound("explosion_2");
+///////////////////////////////////////////////////////////
 
-                // also destroy a projectile emmiter of this enemy:
-                // find a projectile entity and set that its
-                // projectile emitter is not looped anymore (so it will be destroyed)
-                char projectileName[64]{'\0'};
-                strcat(projectileName, pEntt->GetName());
-                strcat(projectileName, "_projectile");
+void Game::OnPlayerMove(void* pGame, const EventPlayerMove& e)
+{
+    Entity* pEntt = g_EntityMgr.GetEnttByID(e.id);
+    if (pEntt)
+        pEntt->GetComponent<Transform>()->SetVelocity(e.velX, e.velY);
+}
 
-                Entity* pProjectileEntt = g_EntityMgr.GetEnttByName(projectileName);
+///////////////////////////////////////////////////////////
 
-                if (pProjectileEntt)
-                    pProjectileEntt->GetComponent<ProjectileEmmiter>()->SetLooped(false);
+void Game::OnPlayerStop(void* pGame, const EventPlayerStop& e)
+{
+    Entity* pEntt = g_EntityMgr.GetEnttByID(e.id);
+    if (pEntt)
+        pEntt->GetComponent<Transform>()->SetVelocity(0,0);
+}
 
-                CreateExplosion(*pEnemyEntt);
-               
-                // destroy the enemy entity
-                g_EntityMgr.DestroyEntt(e.id);
-                g_GameStates.numEnemies--;
+///////////////////////////////////////////////////////////
 
-                break;
-            }
-        }
+void Game::OnPlayerHit(void* pGame, const EventPlayerHitEnemyProjectile& e)
+{
+    Game* pThis = (Game*)pGame;
+
+    // remove one of the lifes sprites
+    char name[16]{'\0'};
+    sprintf(name, "%s%d", "life_", pThis->m_NumLifes);
+
+    Entity* pEntt = g_EntityMgr.GetEnttByName(name);
+    if (pEntt)
+    {
+        g_EntityMgr.DestroyEntt(pEntt->GetID());
     }
 
-    // we handled all the events so clear the list 
-    g_EventMgr.m_Events.clear(); 
+    pThis->m_NumLifes--;
+    g_EntityMgr.DestroyEntt(e.id);
+
+    if (pThis->m_NumLifes == 0)
+        pThis->m_PlayerIsKilled = true;
+}
+
+///////////////////////////////////////////////////////////
+
+void Game::OnDestroyEntity(void* pGame, const EventDestroyEntity& e)
+{
+    g_EntityMgr.DestroyEntt(e.id);
 }
 
+///////////////////////////////////////////////////////////
 
+void Game::OnKillEnemy(void* pGame, const EventKillEnemy& e)
+{
+    Game*   pThis      = (Game*)pGame;
+    Entity* pEnemyEntt = g_EntityMgr.GetEnttByID(e.id);
+
+    if (!pEnemyEntt)
+        return;
+
+    pThis->PlaySound("explosion_2");
+
+    // also destroy a projectile emmiter of this enemy:
+    // find a projectile entity and set that its
+    // projectile emitter is not looped anymore (so it will be destroyed)
+    char projectileName[64]{'\0'};
+    strcat(projectileName, pEnemyEntt->GetName());
+    strcat(projectileName, "_projectile");
+
+    Entity* pProjectileEntt = g_EntityMgr.GetEnttByName(projectileName);
+
+    if (pProjectileEntt)
+        pProjectileEntt->GetComponent<ProjectileEmmiter>()->SetLooped(false);
+
+    pThis->CreateExplosion(*pEnemyEntt);
+   
+    // destroy the enemy entity
+    g_EntityMgr.DestroyEntt(e.id);
+    g_GameStates.numEnemies--;
+}
 
 //---------------------------------------------------------
 // Desc:   a handler for event when the player is shooting
@@ -571,9 +849,9 @@ void Game::CheckCollisions()
 //---------------------------------------------------------
 void Game::ProcessNextLevel(const int levelNumber)
 {
+    // (assets are released by Destroy after the last frame is rendered)
     LogMsg(LOG, "Next level");
     m_Running = false;
-    g_AssetMgr.ClearData(); 
 }
 
 //---------------------------------------------------------
@@ -581,49 +859,68 @@ void Game::ProcessNextLevel(const int levelNumber)
 //---------------------------------------------------------
 void Game::ProcessGameOver()
 {
+    // (the game is destroyed after the last frame is rendered)
     m_Running = false;
-    Destroy();
     LogMsg(LOG, "Game Over");
 }
 
 //---------------------------------------------------------
 // Desc:   visualize bounding-box for each entity which has
-//         a collider component
+//         a collider component (add them into the snapshot)
 //---------------------------------------------------------
-void Game::RenderColliderAABB() const
+void Game::RenderColliderAABB(RenderSnapshot& snapshot) const
 {
     // render visualization of colliders AABB for entities which have the Collider component
 
-    std::vector<Entity*> enttsWithCollider;
-    enttsWithCollider.reserve(32);
+    std::vector<SDL_Rect> dstRects;
+    dstRects.reserve(32);
 
-    // get only entities with collider
+    // get screen rects of entities with collider which are on the screen
     for (Entity* pEntt : g_EntityMgr.GetEntts())
     {
-        if (pEntt->HasComponent<Collider>())
-            enttsWithCollider.push_back(pEntt);
-    }
+        if (!pEntt->HasComponent<Collider>())
+            continue;
+
+        const Sprite* pSprite = pEntt->GetComponent<Sprite>();
 
-    // because we want to render AABB over the sprite, but not the actual collider position we get sprite's dest rect
-    std::vector<SDL_Rect> dstRects(enttsWithCollider.size());
+        // because we want to render AABB over the sprite, but not the actual collider position we get sprite's dest rect
+        if (pSprite)
+        {
+            if (pSprite->IsVisible())
+                dstRects.push_back(pSprite->GetDstRect());
+            continue;
+        }
 
-    for (int i = 0; Entity* pEntt : enttsWithCollider)
-       dstRects[i++] = pEntt->GetComponent<Sprite>()->GetDstRect();
+        // an entity without sprite: the collider's rect in screen space
+        const SDL_Rect& rect    = pEntt->GetComponent<Collider>()->m_ColliderRect;
+        const SDL_Rect  dstRect = {
+            rect.x - (int)g_GameStates.cameraPosX,
+            rect.y - (int)g_GameStates.cameraPosY,
+            rect.w,
+            rect.h };
+
+        if (g_GameStates.IsOnScreen(dstRect.x, dstRect.y, dstRect.w, dstRect.h))
+            dstRects.push_back(dstRect);
+    }
 
     // src rectangle of the AABB texture
     SDL_Texture*    pTexAABB = g_AssetMgr.GetTexture("bounding-box");
     const SDL_Point texSize  = g_AssetMgr.GetTextureSize(pTexAABB);
     const SDL_Rect  srcRect  = {0, 0, texSize.x, texSize.y};  
 
-    // render AABB for each entt with collider    
+    // render AABB for each entt with collider (over all the entities)
+    const uint64_t sortKey = MakeRenderKey(RENDER_LAYER_DEBUG, 0, g_AssetMgr.GetTextureID("bounding-box"));
+
     for (const SDL_Rect& dstRect : dstRects)
-        Render::DrawRectTextured(pTexAABB, srcRect, dstRect, SDL_FLIP_NONE);
+        snapshot.commands.AddCommand(sortKey, pTexAABB, srcRect, dstRect, SDL_FLIP_NONE);
 }
 
 //---------------------------------------------------------
-// Desc:   render all the stuff onto the screen
+// Desc:   fill the render snapshot of the simulated frame: the help
+//         screen or all the entities (and AABB); it doesn't touch SDL
+//         so it's called by the simulation thread in the pipelined mode
 //---------------------------------------------------------
-void Game::Render()
+void Game::ExtractRenderState(RenderSnapshot& snapshot)
 {
     if (m_ShowHelpScreen)
     {
@@ -632,56 +929,156 @@ void Game::Render()
         const SDL_Rect  srcRect = {0, 0, texSize.x, texSize.y};  
         const SDL_Rect  dstRect = {0, 0, g_GameStates.windowWidth, g_GameStates.windowHeight };
 
-        Render::DrawRectTextured(
-            pTex,
-            srcRect,
-            dstRect,
-            SDL_FLIP_NONE);
-
+        snapshot.commands.AddCommand(MakeRenderKey(LAYER_UI, 0, 0), pTex, srcRect, dstRect, SDL_FLIP_NONE);
         return;
     } 
 
     if (g_EntityMgr.HasNoEntts())
         return;
     
-    // render all the entities
-    g_EntityMgr.Render();
+    // add all the entities
+    {
+        PROFILE_ZONE("EntityMgr::Render");
+        g_EntityMgr.Render(snapshot.commands);
+    }
 
-    // render visualization of AABB if need (call it after the main rendering process)
+    m_NumDrawnItems  += snapshot.commands.GetNumCommands();
+    m_NumCulledItems += snapshot.commands.GetNumCulled();
+    m_NumExtractedFrames++;
+
+    // add visualization of AABB if need
     if (m_ShowAABB)
-        RenderColliderAABB();
+        RenderColliderAABB(snapshot);
 
-    // render UI text onto the screen
-    RenderFont();
+    // define the order of drawing
+    {
+        PROFILE_ZONE("RenderCommands::Sort");
+        snapshot.commands.Sort();
+    }
 }
 
 //---------------------------------------------------------
-// Desc:   render the text stuff onto the screen
+// Desc:   update UI text of the last simulated frame and add text labels
+//         into its snapshot; text textures are created here, so it's called
+//         only by the main thread (in the pipelined mode: at the sync
+//         point when the simulation thread is idle)
 //---------------------------------------------------------
-void Game::RenderFont()
+void Game::UpdateUI(RenderSnapshot& snapshot)
 {
-    // render the text (UI elements) onto the screen
+    if (m_ShowHelpScreen || g_EntityMgr.HasNoEntts())
+        return;
 
-    // get entities with TextLabel component
-    Entity* enttsWithTextLabel[32]{nullptr};
-    int numEntts = 0;
+    PROFILE_ZONE("RenderFont");
 
+    if (m_HasNewFrame)
+    {
+        UpdateUIText(m_RealDeltaMs);
+        m_HasNewFrame = false;
+    }
+
+    // add entities with TextLabel component
     for (Entity* pEntt : g_EntityMgr.GetEntts())
     {
-        enttsWithTextLabel[numEntts] = pEntt;
-        numEntts += (pEntt->HasComponent<TextLabel>());
+        if (!pEntt->HasComponent<TextLabel>())
+            continue;
+
+        const TextLabel* pLabel  = pEntt->GetComponent<TextLabel>();
+        const SDL_Rect&  dstRect = pLabel->GetPosition();
+        const SDL_Rect   srcRect = { 0, 0, dstRect.w, dstRect.h };
+
+        snapshot.uiItems.push_back({ pLabel->GetTexture(), srcRect, dstRect, SDL_FLIP_NONE });
     }
+}
+
+//---------------------------------------------------------
+// Desc:   render the snapshot of the frame onto the screen
+//         (and the profiler overlay over it)
+//---------------------------------------------------------
+void Game::Render(const RenderSnapshot& snapshot)
+{
+    Render::DrawSnapshot(snapshot);
+
+    if (!m_ShowHelpScreen && !snapshot.commands.IsEmpty())
+        g_Profiler.RenderOverlay("charriot-font", 10, 60);
+}
+
+//---------------------------------------------------------
+// Desc:   write the last seconds of the trace in Chrome JSON format
+//---------------------------------------------------------
+void Game::DumpTrace(const char* filename)
+{
+    g_TraceRecorder.DumpToFile(filename, m_TraceSeconds);
+}
+
+//---------------------------------------------------------
+// Desc:   append a formatted string to the input one
+//---------------------------------------------------------
+static void AppendFormat(std::string& str, const char* format, ...)
+{
+    char buf[512]{'\0'};
+
+    va_list args;
+    va_start(args, format);
+    vsnprintf(buf, sizeof(buf), format, args);
+    va_end(args);
+
+    str += buf;
+}
+
+//---------------------------------------------------------
+// Desc:   write results of the headless run as a single JSON object:
+//         frame time stats and total/per-frame time of each profiler zone;
+//         the object is built in memory and written into the file at once
+//---------------------------------------------------------
+void Game::ReportBenchmark() const
+{
+    FrameTimeStats frame;
+    g_FrameStats.GetTotalStats(frame);
+
+    std::vector<ProfileZoneStats> zones;
+    g_Profiler.GetStats(zones);
 
-    for (int i = 0; i < numEntts; ++i)
+    const float numFrames = (frame.numFrames > 0) ? (float)frame.numFrames : 1.0f;
+
+    std::string json;
+
+    AppendFormat(json, "{\"scene\":%d,\"frames\":%u,\"fixed_dt_ms\":%u,\"entities\":%u,",
+        m_SceneLevel, frame.numFrames, m_FixedDeltaMs, g_EntityMgr.GetNumEntts());
+
+    AppendFormat(json, "\"frame_ms\":{\"avg\":%.4f,\"p50\":%.4f,\"p95\":%.4f,\"p99\":%.4f,\"max\":%.4f},\"hitches\":%u,",
+        frame.avgMs, frame.p50Ms, frame.p95Ms, frame.p99Ms, frame.maxMs, frame.numHitches);
+
+    // renderables per frame: submitted for drawing vs culled by the camera
+    const double numExtractedFrames = (m_NumExtractedFrames > 0) ? (double)m_NumExtractedFrames : 1.0;
+
+    AppendFormat(json, "\"render\":{\"drawn_avg\":%.1f,\"culled_avg\":%.1f},",
+        m_NumDrawnItems / numExtractedFrames, m_NumCulledItems / numExtractedFrames);
+
+    json += "\"zones\":[";
+
+    for (size_t i = 0; i < zones.size(); ++i)
     {
-        TextLabel* pComponent = enttsWithTextLabel[i]->GetComponent<TextLabel>();
+        const ProfileZoneStats& z = zones[i];
+
+        AppendFormat(json, "%s{\"name\":\"%s\",\"depth\":%d,\"total_ms\":%.4f,\"avg_ms\":%.4f}",
+            (i > 0) ? "," : "",
+            z.name, z.depth, z.totalMs, z.totalMs / numFrames);
+    }
+
+    json += "]}\n";
+
+    FILE* pFile = fopen(m_BenchOutFilename.c_str(), "w");
 
-        SDL_RenderCopy(
-            g_pRenderer, 
-            pComponent->GetTexture(), 
-            NULL, 
-            &pComponent->GetPosition());
+    if (!pFile)
+    {
+        LogErr(LOG, "can't open a file for benchmark results: %s", m_BenchOutFilename.c_str());
+        return;
     }
+
+    fwrite(json.data(), 1, json.size(), pFile);
+    fclose(pFile);
+
+    LogMsg(LOG, "benchmark results are written: %s", m_BenchOutFilename.c_str());
 }
 
 //---------------------------------------------------------
@@ -689,6 +1086,16 @@ void Game::RenderFont()
 //---------------------------------------------------------
 void Game::Destroy()
 {
+    // (the game can be destroyed twice so dump it only once)
+    if (!m_TraceExitFilename.empty())
+    {
+        DumpTrace(m_TraceExitFilename.c_str());
+        m_TraceExitFilename.clear();
+    }
+
+    g_InputRecorder.Stop();
+    g_InputMgr.LogLatencyStats();
+    g_Profiler.ReleaseOverlay();
     g_AssetMgr.ClearData(); 
 }
 
@@ -704,6 +1111,9 @@ void LoadAssets(sol::table assets)
     std::string assetId(64, ' ');
     std::string assetPath(128, ' ');
 
+    // textures are loaded by a single batch (decoding is done in parallel)
+    std::vector<TextureDesc> textures;
+
     while (true)
     {
         sol::optional<sol::table> existsAssetIdxNode = assets[assetIdx];
@@ -723,7 +1133,7 @@ void LoadAssets(sol::table assets)
             // we want to load some texture
             if (assetType == "texture")
             {
-                g_AssetMgr.AddTexture(assetId.c_str(), assetPath.c_str());
+                textures.push_back({ assetId, assetPath });
             }
 
             // load some font
@@ -736,13 +1146,15 @@ void LoadAssets(sol::table assets)
 
         assetIdx++;
     }
+
+    g_AssetMgr.AddTextures(textures);
 }
 
 //---------------------------------------------------------
 // Desc:   load a map from lua config file
 // Args:   - levelMap: data for map initialization
 //---------------------------------------------------------
-void LoadMap(sol::table levelMap)
+void LoadMap(sol::table levelMap, const StressSceneParams& stress)
 {
     LogMsg(LOG, "start loading of map");
 
@@ -751,8 +1163,9 @@ void LoadMap(sol::table levelMap)
 
     const int tileScale     = (int)levelMap["scale"];
     const int tileSize      = (int)levelMap["tileSize"];
-    const int tileMapWidth  = (int)levelMap["mapSizeX"];
-    const int tileMapHeight = (int)levelMap["mapSizeY"];
+    const bool genMap       = (stress.mapSizeX > 0) && (stress.mapSizeY > 0);
+    const int tileMapWidth  = genMap ? stress.mapSizeX : (int)levelMap["mapSizeX"];
+    const int tileMapHeight = genMap ? stress.mapSizeY : (int)levelMap["mapSizeY"];
 
 #if SHOW_DBG_INFO_WHEN_CREATE_ENTITIES
     printf("map tex id:               %s\n", mapTextureId.c_str());
@@ -763,8 +1176,26 @@ void LoadMap(sol::table levelMap)
     printf("map size y (tiles count): %d\n", tileMapHeight);
 #endif
 
-    s_pMap = new Map(mapTextureId.c_str(), tileScale, tileSize);
-    s_pMap->LoadMap(mapPath.c_str(), tileMapWidth, tileMapHeight);
+    g_pMap = new Map(mapTextureId.c_str(), tileScale, tileSize);
+
+    // setup terrain flags of the tileset: [tile code => "solid,water,slow"]
+    const sol::optional<sol::table> tileFlags = levelMap["tileFlags"];
+    if (tileFlags != sol::nullopt)
+    {
+        for (const auto& keyToValue : tileFlags.value())
+        {
+            const int         tileCode = atoi(keyToValue.first.as<std::string>().c_str());
+            const std::string flags    = keyToValue.second.as<std::string>();
+
+            g_pMap->SetTileFlags(tileCode, Map::ParseTileFlags(flags.c_str()));
+        }
+    }
+
+    // the tileset is the same but tiles are random for a stress scene
+    if (genMap)
+        g_pMap->GenerateMap(tileMapWidth, tileMapHeight, stress.seed);
+    else
+        g_pMap->LoadMap(mapPath.c_str(), tileMapWidth, tileMapHeight);
 
     // compute full width and height of the level in pixels
     g_GameStates.levelMapWidth  = tileScale * tileSize * tileMapWidth;
@@ -800,7 +1231,7 @@ void AddTransformComponent(Entity& entt, sol::table tr)
     //printf("\t\trotation: %d\n", rotation);
 #endif
 
-    entt.AddComponent<Transform>(
+    Transform& transform = entt.AddComponent<Transform>(
         posX,
         posY,
         velX,
@@ -808,6 +1239,11 @@ void AddTransformComponent(Entity& entt, sol::table tr)
         width,
         height,
         scale);
+
+    // which terrain flags this entity reacts to (for instance: "solid,water")
+    const sol::optional<std::string> terrain = tr["terrain"];
+    if (terrain != sol::nullopt)
+        transform.m_TerrainMask = Map::ParseTileFlags(terrain.value().c_str());
 }
 
 //---------------------------------------------------------
@@ -889,6 +1325,8 @@ void AddColliderComponent(
     else if (colliderTag == "LEVEL_COMPLETE")
         tag = eColliderTag::LEVEL_COMPLETE;
 
+    else if (colliderTag == "VEGETATION")
+        tag = eColliderTag::VEGETATION;
 
     const int colliderBoxPosX = tr["position"]["x"];
     const int colliderBoxPosY = tr["position"]["y"];
@@ -905,12 +1343,28 @@ void AddColliderComponent(
     printf("\t\theight:       %d\n", colliderBoxHeight);
 #endif
 
-    entt.AddComponent<Collider>(
+    Collider& c = entt.AddComponent<Collider>(
         tag, 
         colliderBoxPosX, 
         colliderBoxPosY,
         colliderBoxWidth,
         colliderBoxHeight);
+
+    // obstacles, vegetation and level complete zone never move so we put
+    // them into the static colliders grid (can be overridden from lua)
+    const eLayerType layer    = entt.GetLayer();
+    const bool       noMove   = ((int)tr["velocity"]["x"] == 0) && ((int)tr["velocity"]["y"] == 0);
+    bool             isStatic = noMove && (
+        (layer == LAYER_VEGETATION) ||
+        (layer == LAYER_OBSTACLE)   ||
+        (tag   == eColliderTag::LEVEL_COMPLETE));
+
+    const sol::optional<bool> staticOverride = collider["static"];
+    if (staticOverride != sol::nullopt)
+        isStatic = staticOverride.value();
+
+    if (isStatic)
+        c.MarkStatic();
 }
 
 //---------------------------------------------------------
@@ -944,32 +1398,19 @@ void AddKeyboardComponent(Entity& entt, sol::table keyboard)
 }
 
 //---------------------------------------------------------
-// Desc:   bind a separate projectile emitter entity
-//         to input entity
-// Args:   - entt:    bind projectile entity to this entity
-//         - emitter: data for the projectile emitter component
+// Desc:   create a projectile emitter entity which is bound to input entity
+//         (by lua data or by the stress scene generator)
 //---------------------------------------------------------
-void AddProjectileEmitterComponent(Entity& entt, sol::table emitter)
+void CreateProjectileEmitter(
+    Entity& entt,
+    const char* assetId,
+    const int speed,
+    const int angleDeg,
+    const int range,
+    const bool loop,
+    const int width,
+    const int height)
 {
-    std::string assetId = emitter["textureAssetId"];
-    const int  speed    = emitter["speed"];
-    const int  angleDeg = emitter["angle"];
-    const int  range    = emitter["range"];
-    const bool loop     = emitter["shouldLoop"];
-    const int  width    = emitter["width"];
-    const int  height   = emitter["height"];
-
-#if SHOW_DBG_INFO_WHEN_CREATE_ENTITIES
-    printf("\t\tAdd projectile emitter component:\n");
-    printf("\t\tspeed:      %d\n", speed);
-    printf("\t\tangleDeg:   %d\n", angleDeg);
-    printf("\t\trange:      %d\n", range);
-
-    printf("\t\tloop(bool): %d\n", loop);
-    printf("\t\twidth:      %d\n", width);
-    printf("\t\theight:     %d\n", height);
-#endif
-
     // create a separate projectile emiter entity
     char projectileName[64]{0};
     strcat(projectileName, entt.GetName());
@@ -997,7 +1438,7 @@ void AddProjectileEmitterComponent(Entity& entt, sol::table emitter)
         height,
         scale);
 
-    projectile.AddComponent<Sprite>(assetId.c_str());
+    projectile.AddComponent<Sprite>(assetId);
 
     projectile.AddComponent<Collider>(
         eColliderTag::PROJECTILE,
@@ -1013,6 +1454,36 @@ void AddProjectileEmitterComponent(Entity& entt, sol::table emitter)
         loop);
 }
 
+//---------------------------------------------------------
+// Desc:   bind a separate projectile emitter entity
+//         to input entity
+// Args:   - entt:    bind projectile entity to this entity
+//         - emitter: data for the projectile emitter component
+//---------------------------------------------------------
+void AddProjectileEmitterComponent(Entity& entt, sol::table emitter)
+{
+    std::string assetId = emitter["textureAssetId"];
+    const int  speed    = emitter["speed"];
+    const int  angleDeg = emitter["angle"];
+    const int  range    = emitter["range"];
+    const bool loop     = emitter["shouldLoop"];
+    const int  width    = emitter["width"];
+    const int  height   = emitter["height"];
+
+#if SHOW_DBG_INFO_WHEN_CREATE_ENTITIES
+    printf("\t\tAdd projectile emitter component:\n");
+    printf("\t\tspeed:      %d\n", speed);
+    printf("\t\tangleDeg:   %d\n", angleDeg);
+    printf("\t\trange:      %d\n", range);
+
+    printf("\t\tloop(bool): %d\n", loop);
+    printf("\t\twidth:      %d\n", width);
+    printf("\t\theight:     %d\n", height);
+#endif
+
+    CreateProjectileEmitter(entt, assetId.c_str(), speed, angleDeg, range, loop, width, height);
+}
+
 //---------------------------------------------------------
 // Desc:   load entities from lua config file
 // Args:   - entts: data container for entities initialization
@@ -1104,11 +1575,124 @@ void LoadEntities(const sol::table entts)
     }
 }
 
+//---------------------------------------------------------
+// Desc:   spawn a lot of entities with the existing components to see how
+//         the engine scales; the level's assets must have the used textures
+//         (tank, projectile, trees); enemies aren't placed near the player
+//         so it isn't killed in the first seconds of a benchmark
+// Args:   - stress:  how many enemies/obstacles to spawn
+//---------------------------------------------------------
+void GenerateStressEntities(const StressSceneParams& stress)
+{
+    const int levelWidth  = (int)g_GameStates.levelMapWidth;
+    const int levelHeight = (int)g_GameStates.levelMapHeight;
+
+    if (levelWidth <= 64 || levelHeight <= 64)
+    {
+        LogErr(LOG, "the level is too small for a stress scene");
+        return;
+    }
+
+    constexpr int   enttSize         = 32;
+    constexpr int   enttScale        = 2;
+    constexpr int   bulletSpeed      = 280;
+    constexpr int   bulletRange      = 300;
+    constexpr int   bulletSize       = 8;
+    constexpr float safeRadiusSqr    = 600.0f * 600.0f;
+    constexpr int   numTreeTextures  = 8;
+
+    Entity*         pPlayer   = g_EntityMgr.GetEnttByName("player");
+    const glm::vec2 playerPos = (pPlayer) ? pPlayer->GetComponent<Transform>()->GetPosition() : glm::vec2(0, 0);
+
+    uint32_t state = stress.seed ? stress.seed : 1;
+
+    // xorshift32: the same seed gives the same scene
+    auto random = [&state](const int maxValue)
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return (int)(state % (uint32_t)maxValue);
+    };
+
+    char name[32];
+
+    for (int i = 0; i < stress.numEnemies; ++i)
+    {
+        int x = 0;
+        int y = 0;
+
+        // (the map can be too small to keep the safe radius so try a few times)
+        for (int attempt = 0; attempt < 8; ++attempt)
+        {
+            x = random(levelWidth  - enttSize * enttScale);
+            y = random(levelHeight - enttSize * enttScale);
+
+            const glm::vec2 toPlayer = glm::vec2(x, y) - playerPos;
+
+            if (glm::dot(toPlayer, toPlayer) > safeRadiusSqr)
+                break;
+        }
+
+        snprintf(name, sizeof(name), "stress_enemy_%d", i);
+        Entity& enemy = g_EntityMgr.AddEntity(name, LAYER_ENEMY);
+
+        enemy.AddComponent<Transform>(x, y, 0, 0, enttSize, enttSize, enttScale);
+        enemy.AddComponent<Sprite>("tank-big-down-texture");
+        enemy.AddComponent<Collider>(eColliderTag::ENEMY, x, y, enttSize, enttSize);
+        g_GameStates.numEnemies++;
+
+        const int angleDeg = random(8) * 45;
+        CreateProjectileEmitter(enemy, "projectile-texture", bulletSpeed, angleDeg, bulletRange, true, bulletSize, bulletSize);
+    }
+
+    for (int i = 0; i < stress.numObstacles; ++i)
+    {
+        const int x = random(levelWidth  - enttSize * enttScale);
+        const int y = random(levelHeight - enttSize * enttScale);
+
+        char textureID[32];
+        snprintf(textureID, sizeof(textureID), "tree-small-%d-texture", 1 + random(numTreeTextures));
+        snprintf(name, sizeof(name), "stress_obstacle_%d", i);
+
+        Entity& obstacle = g_EntityMgr.AddEntity(name, LAYER_VEGETATION);
+
+        obstacle.AddComponent<Transform>(x, y, 0, 0, enttSize/2, enttSize, enttScale);
+        obstacle.AddComponent<Sprite>(textureID);
+        obstacle.AddComponent<Collider>(eColliderTag::VEGETATION, x, y, enttSize/2, enttSize).MarkStatic();
+    }
+
+    LogMsg(LOG, "stress scene: enemies %d, obstacles %d, map %dx%d tiles, seed %u",
+        stress.numEnemies, stress.numObstacles, stress.mapSizeX, stress.mapSizeY, stress.seed);
+}
+
+//---------------------------------------------------------
+// Desc:   read params of a stress scene from the level's "stress" table:
+//         stress = { enemies = 1000, obstacles = 500, mapSizeX = 200, mapSizeY = 200, seed = 1 }
+//---------------------------------------------------------
+void ReadStressParams(const sol::table level, StressSceneParams& outStress)
+{
+    const sol::optional<sol::table> stressNode = level["stress"];
+
+    if (stressNode == sol::nullopt)
+        return;
+
+    const sol::table stress = stressNode.value();
+
+    outStress.numEnemies   = stress.get_or("enemies",   0);
+    outStress.numObstacles = stress.get_or("obstacles", 0);
+    outStress.mapSizeX     = stress.get_or("mapSizeX",  0);
+    outStress.mapSizeY     = stress.get_or("mapSizeY",  0);
+    outStress.seed         = stress.get_or("seed",      1u);
+}
+
 //---------------------------------------------------------
 // Desc:   load level's data from lua script
 // Args:   - levelNumber: which level we will load
+//         - stress:      a stress scene from the command line (if set,
+//                        it replaces the level's "stress" table)
 //---------------------------------------------------------
-void LoadLevelFromLuaScript(const int levelNumber)
+void LoadLevelFromLuaScript(const int levelNumber, const StressSceneParams& cmdStress)
 {
     // define the filename to load level
     char levelName[32]{'\0'};
@@ -1132,11 +1716,23 @@ void LoadLevelFromLuaScript(const int levelNumber)
     LogDbg(LOG, "Load level from lua file: %s", luaScriptPath);
     lua.script_file(luaScriptPath);
 
+    StressSceneParams stress = cmdStress;
+
+    if (!stress.IsSet())
+        ReadStressParams(lua[levelName], stress);
+
     // load stuff from lua script
     LoadAssets(lua[levelName]["assets"]);
-    LoadMap(lua[levelName]["map"]);
+    LoadMap(lua[levelName]["map"], stress);
     LoadEntities(lua[levelName]["entities"]);
 
+    if (stress.IsSet())
+        GenerateStressEntities(stress);
+
+    // static colliders and tiles never move so we build their grids only once
+    g_EntityMgr.BuildStaticColliders();
+    g_EntityMgr.BuildTileGrid();
+
     // setup a pointer to the player's entity
     Entity* pEnttPlayer = g_EntityMgr.GetEnttByName("player");
     if (!pEnttPlayer)
@@ -1155,7 +1751,7 @@ void LoadLevelFromLuaScript(const int levelNumber)
 //---------------------------------------------------------
 void Game::LoadLevel(const int levelNumber)
 {
-    LoadLevelFromLuaScript(levelNumber);
+    LoadLevelFromLuaScript(levelNumber, m_Stress);
 
     // create text entities
     Entity& labelLevelName = g_EntityMgr.AddEntity("LabelLevelName", LAYER_UI);
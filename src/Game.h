@@ -9,9 +9,24 @@
 #define GAME_H
 
 #include "Entity.h"
+#include "InputRecorder.h"
+#include "RenderSnapshot.h"
 #include <SDL2/SDL.h>
+#include <string>
 #include "../lib/lua/sol.hpp"
 
+// a procedurally generated scene for scaling tests; it is set by the level's
+// "stress" table in lua or by the command line (which has priority)
+struct StressSceneParams
+{
+    int      numEnemies   = 0;        // enemies with projectile emitters
+    int      numObstacles = 0;        // static vegetation colliders
+    int      mapSizeX     = 0;        // if not zero the tilemap is generated (in tiles)
+    int      mapSizeY     = 0;
+    uint32_t seed         = 1;
+
+    inline bool IsSet() const { return numEnemies || numObstacles || mapSizeX || mapSizeY; }
+};
 
 class Game
 {
@@ -19,6 +34,7 @@ public:
     Game();
     ~Game();
     
+    void ParseCommandLine(int argc, char* argv[]);
     void Initialize();
     void ProcessInput();
 
@@ -30,26 +46,46 @@ public:
 
     void Destroy();
 
-    void Render();
-    void RenderFont();
+    void ExtractRenderState(RenderSnapshot& snapshot);
+    void UpdateUI(RenderSnapshot& snapshot);
+    void Render(const RenderSnapshot& snapshot);
 
     void LoadLevel(const int levelNumber);
     void CheckCollisions();
 
     void ProcessNextLevel(const int levelNumber);
     void ProcessGameOver();
-    inline bool IsRunning() const { return m_Running; }
+    inline bool IsRunning()  const { return m_Running; }
+    inline bool IsHeadless() const { return m_IsHeadless; }
+    inline bool IsPipelined() const { return m_IsPipelined; }
+
+    void ReportBenchmark() const;
 
 private:
-    void RenderColliderAABB() const;
+    void RenderColliderAABB(RenderSnapshot& snapshot) const;
+    void DumpTrace(const char* filename);
+    void PollInput();
+    void StartInputRecorder();
+    uint64_t ComputeStateHash() const;
+
+    // event handlers (are subscribed to the event manager)
+    void SubscribeToEvents();
+
+    static void OnSwitchAnimation(void* pGame, const EventSwitchAnimation& e);
+    static void OnPlayerShoot    (void* pGame, const EventPlayerShoot& e);
+    static void OnPlayerMove     (void* pGame, const EventPlayerMove& e);
+    static void OnPlayerStop     (void* pGame, const EventPlayerStop& e);
+    static void OnPlayerHit      (void* pGame, const EventPlayerHitEnemyProjectile& e);
+    static void OnDestroyEntity  (void* pGame, const EventDestroyEntity& e);
+    static void OnKillEnemy      (void* pGame, const EventKillEnemy& e);
 
     void HandleEventPlayerShoot(Entity& player);
     void CreateExplosion(Entity& enemy);
     void PlaySound(const char* soundName);
 
 public:
-    static SDL_Event ms_Event;
-    static SDL_Rect  ms_Camera;
+    static SDL_Rect   ms_Camera;
+    static InputFrame ms_Input;           // input which is used by the simulation
 
 private:
     bool             m_Running        = true;
@@ -61,6 +97,33 @@ private:
     uint32_t         m_NumDrawnFrames = 0;
     float            m_FpsValue       = 0;
     int              m_NumLifes       = 3;
+    uint32_t         m_FixedDeltaMs   = 0;          // if not zero the simulation has a fixed timestep
+    uint32_t         m_RealDeltaMs    = 0;          // of the last simulated frame (for UI)
+    bool             m_HasNewFrame    = false;      // a frame is simulated since the last UI update
+
+    // camera culling statistics of all the extracted frames
+    uint64_t         m_NumDrawnItems  = 0;          // renderables which are on the screen
+    uint64_t         m_NumCulledItems = 0;          // off-screen ones (skipped)
+    uint32_t         m_NumExtractedFrames = 0;
+
+    // simulation and rendering are on separate threads (see FramePipeline)
+    bool             m_IsPipelined    = true;
+
+    // input recording/replay (are set by the command line)
+    std::string      m_RecordFilename;
+    std::string      m_ReplayFilename;
+
+    // a trace of the last seconds can be dumped by hotkey or on exit
+    float            m_TraceSeconds   = 5.0f;
+    std::string      m_TraceExitFilename;
+
+    // headless benchmark: a fixed num of frames of the scene without a real window/audio
+    bool             m_IsHeadless     = false;
+    uint32_t         m_NumBenchFrames = 0;          // if not zero the game stops after these frames
+    uint32_t         m_NumFramesDone  = 0;
+    int              m_SceneLevel     = 1;
+    std::string      m_BenchOutFilename = "benchmark.json";   // not stdout: log messages go there
+    StressSceneParams m_Stress;
 };
 
 #endif
@@ -33,6 +33,15 @@ struct GameStates
         halfWndWidth  = windowWidth / 2;
         halfWndHeight = windowHeight / 2;
     }
+
+    // check if a rect in screen space is at least partially in the window;
+    // it's the same as a test of the rect in world space against the camera
+    // (Game::ms_Camera is the window rect at the camera position)
+    inline bool IsOnScreen(const int x, const int y, const int width, const int height) const
+    {
+        return (x < (int)windowWidth) && (x + width > 0) &&
+               (y < (int)windowHeight) && (y + height > 0);
+    }
 };
 
 extern GameStates g_GameStates;
@@ -7,17 +7,39 @@
 #ifndef ICOMPONENT_H
 #define ICOMPONENT_H
 
+#include "Types.h"
+
 class Entity;
+class RenderCommandBuffer;
+
+// types of components: systems of the scheduler declare which types
+// they read/write (see SystemScheduler.h), so each concrete component
+// has a static TYPE which is stored into m_Type when it's added to entity
+enum eComponentType
+{
+    COMPONENT_TRANSFORM,
+    COMPONENT_SPRITE,
+    COMPONENT_COLLIDER,
+    COMPONENT_KEYBOARD_CONTROL,
+    COMPONENT_PROJECTILE_EMITTER,
+    COMPONENT_TILE,
+    COMPONENT_TEXT_LABEL,
+    COMPONENT_LIFE_TIMER,
+
+    NUM_COMPONENT_TYPES,
+    COMPONENT_UNKNOWN = NUM_COMPONENT_TYPES,
+};
 
 class IComponent
 {
 public:
-    Entity* m_pOwner = nullptr;
+    Entity*        m_pOwner = nullptr;
+    eComponentType m_Type   = COMPONENT_UNKNOWN;
 
     virtual ~IComponent() {}
     virtual void Initialize() {}
     virtual void Update(const float deltaTime) {}
-    virtual void Render() {}
+    virtual void Render(RenderCommandBuffer& commands, const eLayerType layer) {}   // add draw commands of the component
 
     virtual Entity* GetOwner() const { return m_pOwner; }
 
@@ -0,0 +1,243 @@
+// ==================================================================
+// Filename:    InputMgr.cpp
+// Created:     19.10.2026 by DimaSkup
+// ==================================================================
+#include "InputMgr.h"
+#include "Log.h"
+#include <string.h>
+
+// init a global instance of the input manager
+InputMgr g_InputMgr;
+
+
+///////////////////////////////////////////////////////////
+
+InputMgr::InputMgr()
+{
+    memset(m_IsKeyDown,   0, sizeof(m_IsKeyDown));
+    memset(m_NumHeldKeys, 0, sizeof(m_NumHeldKeys));
+    ResetBindings();
+}
+
+//---------------------------------------------------------
+// Desc:   setup default key bindings of the game
+//---------------------------------------------------------
+void InputMgr::ResetBindings()
+{
+    memset(m_ActionsByScancode, 0, sizeof(m_ActionsByScancode));
+
+    BindScancode(SDL_SCANCODE_UP,     INPUT_ACTION_UP);
+    BindScancode(SDL_SCANCODE_DOWN,   INPUT_ACTION_DOWN);
+    BindScancode(SDL_SCANCODE_RIGHT,  INPUT_ACTION_RIGHT);
+    BindScancode(SDL_SCANCODE_LEFT,   INPUT_ACTION_LEFT);
+    BindScancode(SDL_SCANCODE_SPACE,  INPUT_ACTION_SHOOT);
+    BindScancode(SDL_SCANCODE_RETURN, INPUT_ACTION_CONFIRM);
+    BindScancode(SDL_SCANCODE_F2,     INPUT_ACTION_TOGGLE_AABB);
+    BindScancode(SDL_SCANCODE_ESCAPE, INPUT_ACTION_EXIT);
+    BindScancode(SDL_SCANCODE_F3,     INPUT_ACTION_TOGGLE_PROFILER);
+    BindScancode(SDL_SCANCODE_F4,     INPUT_ACTION_DUMP_TRACE);
+}
+
+//---------------------------------------------------------
+// Desc:   bind a key by its name (for instance from Lua: "w", "space")
+//         to the action; a key can be bound to several actions and
+//         an action can have several keys
+// Ret:    false if there is no such key
+//---------------------------------------------------------
+bool InputMgr::BindKey(const char* keyName, const eInputAction action)
+{
+    if (!keyName || keyName[0] == '\0')
+        return false;
+
+    const SDL_Scancode scancode = SDL_GetScancodeFromName(keyName);
+
+    if (scancode == SDL_SCANCODE_UNKNOWN)
+    {
+        LogErr(LOG, "unknown key name: %s", keyName);
+        return false;
+    }
+
+    BindScancode(scancode, action);
+    return true;
+}
+
+///////////////////////////////////////////////////////////
+
+void InputMgr::BindScancode(const SDL_Scancode scancode, const eInputAction action)
+{
+    m_ActionsByScancode[scancode] |= ActionBit(action);
+}
+
+
+//---------------------------------------------------------
+// Desc:   drain all the pending SDL events and compute
+//         the state of game keys for this frame
+//---------------------------------------------------------
+void InputMgr::PollEvents()
+{
+    m_Frame.pressedActions  = 0;
+    m_Frame.releasedActions = 0;
+    m_FrameEventsStart      = m_NextEvent;
+    m_NumFrameEvents        = 0;
+
+    SDL_Event event;
+
+    while (SDL_PollEvent(&event))
+    {
+        switch (event.type)
+        {
+            case SDL_QUIT:
+            {
+                InputEvent e;
+                e.timestamp = SDL_GetTicks();
+                e.type      = SDL_QUIT;
+                e.actions   = ActionBit(INPUT_ACTION_EXIT);
+                PushEvent(e);
+
+                m_Frame.pressedActions |= e.actions;
+                break;
+            }
+            case SDL_KEYDOWN:
+            case SDL_KEYUP:
+            {
+                const SDL_Scancode scancode = event.key.keysym.scancode;
+                const bool         isDown   = (event.type == SDL_KEYDOWN);
+
+                // skip repeats (and unpaired events, for instance after focus change)
+                if (scancode < 0 || scancode >= SDL_NUM_SCANCODES || m_IsKeyDown[scancode] == isDown)
+                    break;
+
+                m_IsKeyDown[scancode] = isDown;
+
+                InputEvent e;
+                e.timestamp = event.key.timestamp;
+                e.type      = event.type;
+                e.scancode  = scancode;
+                e.actions   = m_ActionsByScancode[scancode];
+                PushEvent(e);
+
+                if (isDown)
+                    OnKeyDown(e.actions);
+                else
+                    OnKeyUp(e.actions);
+
+                break;
+            }
+        }
+    }
+}
+
+//---------------------------------------------------------
+// Desc:   remember game key presses of the current frame events
+//         (is called after PollEvents when it's known which frame
+//         will be simulated with this input)
+// Args:   - frameIdx:  an index of the frame which gets the input
+//---------------------------------------------------------
+void InputMgr::TagFrameEvents(const uint32_t frameIdx)
+{
+    for (uint32_t i = 0; i < m_NumFrameEvents; ++i)
+    {
+        const InputEvent& e = GetFrameEvent(i);
+
+        if (e.type != SDL_KEYDOWN || !e.actions)
+            continue;
+
+        // too many presses are waiting for their frames: skip the sample
+        if (m_PressesTail - m_PressesHead >= INPUT_PRESSES_CAPACITY)
+            return;
+
+        PendingPress& press = m_Presses[m_PressesTail & (INPUT_PRESSES_CAPACITY-1)];
+        press.timestamp = e.timestamp;
+        press.frameIdx  = frameIdx;
+        m_PressesTail++;
+    }
+}
+
+//---------------------------------------------------------
+// Desc:   is called when the frame is presented: the latency is the time
+//         from pressing of a game key until now, for presses which went
+//         into this frame (or earlier ones)
+// Args:   - presentedFrameIdx:  an index of the presented frame
+//---------------------------------------------------------
+void InputMgr::MeasureLatency(const uint32_t presentedFrameIdx)
+{
+    const uint32_t now = SDL_GetTicks();
+
+    for (; m_PressesHead != m_PressesTail; ++m_PressesHead)
+    {
+        const PendingPress& press = m_Presses[m_PressesHead & (INPUT_PRESSES_CAPACITY-1)];
+
+        if (press.frameIdx > presentedFrameIdx)
+            break;
+
+        const uint32_t latencyMs = now - press.timestamp;
+
+        m_SumLatencyMs += latencyMs;
+        m_NumLatencySamples++;
+
+        if (latencyMs > m_MaxLatencyMs)
+            m_MaxLatencyMs = latencyMs;
+    }
+}
+
+//---------------------------------------------------------
+// Desc:   print input-to-present latency stats
+//---------------------------------------------------------
+void InputMgr::LogLatencyStats() const
+{
+    if (m_NumLatencySamples == 0)
+        return;
+
+    LogMsg(LOG, "input latency: avg %.2f ms, max %u ms (samples: %u)",
+        GetAvgLatencyMs(), m_MaxLatencyMs, m_NumLatencySamples);
+}
+
+//---------------------------------------------------------
+// Desc:   an action is pressed when the first of its keys goes down
+//         and released when the last of them goes up
+//---------------------------------------------------------
+void InputMgr::OnKeyDown(const InputActionMask actions)
+{
+    for (int a = 0; a < NUM_INPUT_ACTIONS; ++a)
+    {
+        if (!(actions & ActionBit((eInputAction)a)))
+            continue;
+
+        if (m_NumHeldKeys[a]++ == 0)
+        {
+            m_Frame.pressedActions |= ActionBit((eInputAction)a);
+            m_Frame.heldActions    |= ActionBit((eInputAction)a);
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////
+
+void InputMgr::OnKeyUp(const InputActionMask actions)
+{
+    for (int a = 0; a < NUM_INPUT_ACTIONS; ++a)
+    {
+        if (!(actions & ActionBit((eInputAction)a)) || m_NumHeldKeys[a] == 0)
+            continue;
+
+        if (--m_NumHeldKeys[a] == 0)
+        {
+            m_Frame.releasedActions |= ActionBit((eInputAction)a);
+            m_Frame.heldActions     &= ~ActionBit((eInputAction)a);
+        }
+    }
+}
+
+//---------------------------------------------------------
+// Desc:   store an event into the ring (the oldest one is overwritten)
+//---------------------------------------------------------
+void InputMgr::PushEvent(const InputEvent& e)
+{
+    m_Events[m_NextEvent & (INPUT_EVENTS_CAPACITY-1)] = e;
+    m_NextEvent++;
+
+    if (m_NumFrameEvents < INPUT_EVENTS_CAPACITY)
+        m_NumFrameEvents++;
+    else
+        m_FrameEventsStart++;
+}
@@ -0,0 +1,145 @@
+// ==================================================================
+// Filename:    InputMgr.h
+// Description: an input system: each frame it drains all the pending
+//              SDL events (so a key down + key up + quit in one frame
+//              aren't spread over several frames) into a timestamped
+//              ring buffer and computes per-frame state of game actions:
+//              pressed / released during this frame, and held;
+//              it also measures input-to-present latency: key presses
+//              are tagged with the index of the frame which they go into,
+//              and are measured when that frame is presented (in the
+//              pipelined mode it's the next one after the input)
+//
+//              Key bindings (for instance from Lua) are compiled once into
+//              a table [scancode => bitmask of actions], so per event we
+//              only do a lookup, and users query actions by index
+//
+// Created:     19.10.2026 by DimaSkup
+// ==================================================================
+#ifndef INPUT_MGR_H
+#define INPUT_MGR_H
+
+#include <SDL2/SDL.h>
+#include <stdint.h>
+
+// game actions which can be bound to keys
+enum eInputAction
+{
+    INPUT_ACTION_UP,
+    INPUT_ACTION_DOWN,
+    INPUT_ACTION_RIGHT,
+    INPUT_ACTION_LEFT,
+    INPUT_ACTION_SHOOT,
+    INPUT_ACTION_CONFIRM,
+    INPUT_ACTION_TOGGLE_AABB,
+    INPUT_ACTION_EXIT,              // escape or closing of the window
+    INPUT_ACTION_TOGGLE_PROFILER,
+    INPUT_ACTION_DUMP_TRACE,
+
+    NUM_INPUT_ACTIONS,
+};
+
+using InputActionMask = uint16_t;
+
+inline InputActionMask ActionBit(const eInputAction action) { return 1 << action; }
+
+constexpr InputActionMask INPUT_ACTIONS_MOVE =
+    (1 << INPUT_ACTION_UP) | (1 << INPUT_ACTION_DOWN) | (1 << INPUT_ACTION_RIGHT) | (1 << INPUT_ACTION_LEFT);
+
+// state of the game actions during one frame (it is all the simulation knows about input)
+struct InputFrame
+{
+    InputActionMask heldActions     = 0;      // bitmasks by eInputAction
+    InputActionMask pressedActions  = 0;
+    InputActionMask releasedActions = 0;
+
+    inline bool IsHeld    (const eInputAction a) const { return heldActions     & ActionBit(a); }
+    inline bool IsPressed (const eInputAction a) const { return pressedActions  & ActionBit(a); }
+    inline bool IsReleased(const eInputAction a) const { return releasedActions & ActionBit(a); }
+
+    inline bool operator!=(const InputFrame& rhs) const
+    {
+        return (heldActions     != rhs.heldActions)    ||
+               (pressedActions  != rhs.pressedActions) ||
+               (releasedActions != rhs.releasedActions);
+    }
+};
+
+// an input event which is stored in the ring buffer
+struct InputEvent
+{
+    uint32_t        timestamp = 0;      // in ms (SDL ticks) when the event happened
+    uint32_t        type      = 0;      // SDL_KEYDOWN, SDL_KEYUP or SDL_QUIT
+    SDL_Scancode    scancode  = SDL_SCANCODE_UNKNOWN;
+    InputActionMask actions   = 0;      // actions which are bound to the scancode
+};
+
+constexpr int INPUT_EVENTS_CAPACITY  = 256;   // power of 2
+constexpr int INPUT_PRESSES_CAPACITY = 64;    // key presses which aren't presented yet (power of 2)
+
+class InputMgr
+{
+public:
+    InputMgr();
+
+    void ResetBindings();
+    bool BindKey(const char* keyName, const eInputAction action);
+    void BindScancode(const SDL_Scancode scancode, const eInputAction action);
+
+    void PollEvents();
+    void TagFrameEvents(const uint32_t frameIdx);
+    void MeasureLatency(const uint32_t presentedFrameIdx);
+    void LogLatencyStats() const;
+
+    inline const InputFrame& GetFrame()             const { return m_Frame; }
+    inline uint32_t          GetNumFrameEvents()    const { return m_NumFrameEvents; }
+
+    // events of the current frame by index in [0, GetNumFrameEvents())
+    inline const InputEvent& GetFrameEvent(const uint32_t i) const
+    {   return m_Events[(m_FrameEventsStart + i) & (INPUT_EVENTS_CAPACITY-1)];   }
+
+    inline float    GetAvgLatencyMs() const { return (m_NumLatencySamples) ? (float)m_SumLatencyMs / m_NumLatencySamples : 0.0f; }
+    inline uint32_t GetMaxLatencyMs() const { return m_MaxLatencyMs; }
+
+private:
+    void PushEvent(const InputEvent& e);
+    void OnKeyDown(const InputActionMask actions);
+    void OnKeyUp(const InputActionMask actions);
+
+private:
+    InputFrame      m_Frame;
+
+    // compiled bindings, and how many bound keys hold each action
+    InputActionMask m_ActionsByScancode[SDL_NUM_SCANCODES];
+    bool            m_IsKeyDown[SDL_NUM_SCANCODES];
+    uint8_t         m_NumHeldKeys[NUM_INPUT_ACTIONS];
+
+    // a ring of the recent events (the current frame events are the last ones)
+    InputEvent m_Events[INPUT_EVENTS_CAPACITY];
+    uint32_t   m_NextEvent         = 0;
+    uint32_t   m_FrameEventsStart  = 0;
+    uint32_t   m_NumFrameEvents    = 0;
+
+    // key presses which wait for presenting of their frames (in order of frames)
+    struct PendingPress
+    {
+        uint32_t timestamp = 0;         // in ms (SDL ticks)
+        uint32_t frameIdx  = 0;         // the frame which the press goes into
+    };
+
+    PendingPress m_Presses[INPUT_PRESSES_CAPACITY];
+    uint32_t     m_PressesHead     = 0;
+    uint32_t     m_PressesTail     = 0;
+
+    // input-to-present latency of pressed keys
+    uint64_t   m_SumLatencyMs      = 0;
+    uint32_t   m_NumLatencySamples = 0;
+    uint32_t   m_MaxLatencyMs      = 0;
+};
+
+// ==================================================================
+// Declare a global instance of the input manager
+// ==================================================================
+extern InputMgr g_InputMgr;
+
+#endif
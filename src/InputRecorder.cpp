@@ -0,0 +1,216 @@
+// ==================================================================
+// Filename:    InputRecorder.cpp
+// Created:     19.10.2026 by DimaSkup
+// ==================================================================
+#include "InputRecorder.h"
+#include "Log.h"
+#include <string.h>
+
+// init a global instance of the input recorder
+InputRecorder g_InputRecorder;
+
+static const char     REC_MAGIC[4]   = { 'D', 'R', 'E', 'C' };
+static const uint32_t REC_VERSION    = 2;
+static const long     REC_HEADER_LEN = 4 + 4 + 4 + 4 + 8;
+
+// FNV-1a params for the chain of state hashes
+static const uint64_t FNV_OFFSET     = 14695981039346656037ULL;
+static const uint64_t FNV_PRIME      = 1099511628211ULL;
+
+
+//---------------------------------------------------------
+// Desc:   open a file and start recording of input
+// Args:   - filename:      path to the file of recording
+//         - fixedDeltaMs:  the timestep of the simulation during recording
+//---------------------------------------------------------
+bool InputRecorder::StartRecording(const char* filename, const uint32_t fixedDeltaMs)
+{
+    Stop();
+
+    if (fixedDeltaMs == 0)
+    {
+        LogErr(LOG, "can't record input without a fixed timestep");
+        return false;
+    }
+
+    m_pFile = fopen(filename, "wb");
+    if (!m_pFile)
+    {
+        LogErr(LOG, "can't open a file for input recording: %s", filename);
+        return false;
+    }
+
+    // the header is rewritten with actual values when the recording is stopped
+    const uint32_t numFrames = 0;
+    const uint64_t hash      = 0;
+
+    fwrite(REC_MAGIC,     sizeof(REC_MAGIC),   1, m_pFile);
+    fwrite(&REC_VERSION,  sizeof(REC_VERSION), 1, m_pFile);
+    fwrite(&fixedDeltaMs, sizeof(uint32_t),    1, m_pFile);
+    fwrite(&numFrames,    sizeof(uint32_t),    1, m_pFile);
+    fwrite(&hash,         sizeof(uint64_t),    1, m_pFile);
+
+    m_Mode         = INPUT_RECORDER_MODE_RECORD;
+    m_FixedDeltaMs = fixedDeltaMs;
+    m_FrameIdx     = 0;
+    m_StateHash    = FNV_OFFSET;
+    m_PrevInput    = InputFrame();
+
+    LogMsg(LOG, "input recording is started: %s (fixed dt: %u ms)", filename, fixedDeltaMs);
+    return true;
+}
+
+//---------------------------------------------------------
+// Desc:   load a recording from the file and start replaying it
+// Args:   - filename:  path to the file of recording
+//---------------------------------------------------------
+bool InputRecorder::StartReplay(const char* filename)
+{
+    Stop();
+
+    FILE* pFile = fopen(filename, "rb");
+    if (!pFile)
+    {
+        LogErr(LOG, "can't open a file of input recording: %s", filename);
+        return false;
+    }
+
+    char     magic[4]{0};
+    uint32_t version = 0;
+    bool     isRead  = true;
+
+    isRead &= (fread(magic,           sizeof(magic),    1, pFile) == 1);
+    isRead &= (fread(&version,        sizeof(uint32_t), 1, pFile) == 1);
+    isRead &= (fread(&m_FixedDeltaMs, sizeof(uint32_t), 1, pFile) == 1);
+    isRead &= (fread(&m_NumFrames,    sizeof(uint32_t), 1, pFile) == 1);
+    isRead &= (fread(&m_RecordedHash, sizeof(uint64_t), 1, pFile) == 1);
+
+    if (!isRead || memcmp(magic, REC_MAGIC, sizeof(magic)) != 0 || version != REC_VERSION)
+    {
+        LogErr(LOG, "invalid file of input recording: %s", filename);
+        fclose(pFile);
+        return false;
+    }
+
+    m_Records.clear();
+
+    while (true)
+    {
+        Record rec;
+        bool   isReadRec = true;
+
+        isReadRec &= (fread(&rec.frameIdx,              sizeof(uint32_t),        1, pFile) == 1);
+        isReadRec &= (fread(&rec.input.heldActions,     sizeof(InputActionMask), 1, pFile) == 1);
+        isReadRec &= (fread(&rec.input.pressedActions,  sizeof(InputActionMask), 1, pFile) == 1);
+        isReadRec &= (fread(&rec.input.releasedActions, sizeof(InputActionMask), 1, pFile) == 1);
+
+        if (!isReadRec)
+            break;
+
+        m_Records.push_back(rec);
+    }
+
+    fclose(pFile);
+
+    m_Mode       = INPUT_RECORDER_MODE_REPLAY;
+    m_FrameIdx   = 0;
+    m_NextRecord = 0;
+    m_StateHash  = FNV_OFFSET;
+    m_PrevInput  = InputFrame();
+
+    LogMsg(LOG, "input replay is started: %s (frames: %u, records: %d, fixed dt: %u ms)",
+        filename, m_NumFrames, (int)m_Records.size(), m_FixedDeltaMs);
+    return true;
+}
+
+//---------------------------------------------------------
+// Desc:   finish recording/replaying; for recording we update
+//         the header, for replay we compare the state with recorded one
+//---------------------------------------------------------
+void InputRecorder::Stop()
+{
+    if (IsRecording())
+    {
+        fseek(m_pFile, REC_HEADER_LEN - 12, SEEK_SET);
+        fwrite(&m_FrameIdx,  sizeof(uint32_t), 1, m_pFile);
+        fwrite(&m_StateHash, sizeof(uint64_t), 1, m_pFile);
+        fclose(m_pFile);
+        m_pFile = nullptr;
+
+        LogMsg(LOG, "input recording is stopped (frames: %u, state hash: %016llx)",
+            m_FrameIdx, (unsigned long long)m_StateHash);
+    }
+    else if (IsReplaying())
+    {
+        if (m_FrameIdx == m_NumFrames && m_StateHash == m_RecordedHash)
+        {
+            LogMsg(LOG, "input replay is stopped: the simulation matches the recording "
+                "(frames: %u, state hash: %016llx)", m_FrameIdx, (unsigned long long)m_StateHash);
+        }
+        else
+        {
+            LogErr(LOG, "input replay is stopped: the simulation diverged from the recording "
+                "(frames: %u/%u, state hash: %016llx, recorded: %016llx)",
+                m_FrameIdx, m_NumFrames,
+                (unsigned long long)m_StateHash,
+                (unsigned long long)m_RecordedHash);
+        }
+
+        m_Records.clear();
+    }
+
+    m_Mode = INPUT_RECORDER_MODE_NONE;
+}
+
+//---------------------------------------------------------
+// Desc:   write the input of the current frame (only if it is changed)
+//---------------------------------------------------------
+void InputRecorder::RecordFrame(const InputFrame& input)
+{
+    if (!IsRecording())
+        return;
+
+    if (input != m_PrevInput)
+    {
+        fwrite(&m_FrameIdx,             sizeof(uint32_t),        1, m_pFile);
+        fwrite(&input.heldActions,      sizeof(InputActionMask), 1, m_pFile);
+        fwrite(&input.pressedActions,   sizeof(InputActionMask), 1, m_pFile);
+        fwrite(&input.releasedActions,  sizeof(InputActionMask), 1, m_pFile);
+
+        m_PrevInput = input;
+    }
+
+    m_FrameIdx++;
+}
+
+//---------------------------------------------------------
+// Desc:   get the input of the current frame from the recording
+// Ret:    false if all the recorded frames are over
+//---------------------------------------------------------
+bool InputRecorder::ReplayFrame(InputFrame& outInput)
+{
+    if (!IsReplaying() || m_FrameIdx >= m_NumFrames)
+        return false;
+
+    if (m_NextRecord < m_Records.size() && m_Records[m_NextRecord].frameIdx == m_FrameIdx)
+    {
+        m_PrevInput = m_Records[m_NextRecord].input;
+        m_NextRecord++;
+    }
+
+    outInput = m_PrevInput;
+    m_FrameIdx++;
+    return true;
+}
+
+//---------------------------------------------------------
+// Desc:   add a hash of the simulation state after the frame into the chain
+//---------------------------------------------------------
+void InputRecorder::AddStateHash(const uint64_t hash)
+{
+    for (int i = 0; i < 8; ++i)
+    {
+        m_StateHash ^= (hash >> (i * 8)) & 0xFF;
+        m_StateHash *= FNV_PRIME;
+    }
+}
@@ -0,0 +1,76 @@
+// ==================================================================
+// Filename:    InputRecorder.h
+// Description: records input of each frame into a compact file and
+//              replays it back; together with a fixed timestep a replay
+//              gives the same simulation so we can compare engine changes
+//              on the same gameplay trace:
+//              - only frames where the input is changed are written
+//              - a chain of per-frame state hashes is stored in the header,
+//                so the replay can tell if the simulation diverged
+//
+//              File layout:
+//              header:  "DREC", version, fixed dt (ms), num frames, state hash
+//              records: frame idx, held, pressed and released actions
+//
+// Created:     19.10.2026 by DimaSkup
+// ==================================================================
+#ifndef INPUT_RECORDER_H
+#define INPUT_RECORDER_H
+
+#include "InputMgr.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <vector>
+
+enum eInputRecorderMode
+{
+    INPUT_RECORDER_MODE_NONE,
+    INPUT_RECORDER_MODE_RECORD,
+    INPUT_RECORDER_MODE_REPLAY,
+};
+
+class InputRecorder
+{
+public:
+    ~InputRecorder() { Stop(); }
+
+    bool StartRecording(const char* filename, const uint32_t fixedDeltaMs);
+    bool StartReplay(const char* filename);
+    void Stop();
+
+    void RecordFrame(const InputFrame& input);
+    bool ReplayFrame(InputFrame& outInput);
+    void AddStateHash(const uint64_t hash);
+
+    inline bool     IsRecording()     const { return m_Mode == INPUT_RECORDER_MODE_RECORD; }
+    inline bool     IsReplaying()     const { return m_Mode == INPUT_RECORDER_MODE_REPLAY; }
+    inline bool     IsActive()        const { return m_Mode != INPUT_RECORDER_MODE_NONE; }
+    inline uint32_t GetFixedDeltaMs() const { return m_FixedDeltaMs; }
+
+private:
+    struct Record
+    {
+        uint32_t   frameIdx = 0;
+        InputFrame input;
+    };
+
+    eInputRecorderMode  m_Mode         = INPUT_RECORDER_MODE_NONE;
+    FILE*               m_pFile        = nullptr;
+    uint32_t            m_FixedDeltaMs = 0;
+    uint32_t            m_FrameIdx     = 0;
+    uint64_t            m_StateHash    = 0;    // a chain of per-frame hashes
+    InputFrame          m_PrevInput;
+
+    // replay data
+    std::vector<Record> m_Records;
+    size_t              m_NextRecord   = 0;
+    uint32_t            m_NumFrames    = 0;    // how many frames were recorded
+    uint64_t            m_RecordedHash = 0;
+};
+
+// ==================================================================
+// Declare a global instance of the input recorder
+// ==================================================================
+extern InputRecorder g_InputRecorder;
+
+#endif
@@ -0,0 +1,393 @@
+// ==================================================================
+// Filename:    JobSystem.cpp
+// Created:     19.10.2026 by DimaSkup
+// ==================================================================
+#include "JobSystem.h"
+#include "Log.h"
+#include "TraceRecorder.h"
+
+// init a global instance of the job system
+JobSystem g_JobSystem;
+
+// how many times an idle worker tries to find a job before it sleeps
+constexpr int JOB_SPIN_COUNT = 256;
+
+// a queue of the current thread (nullptr if the thread hasn't submitted anything yet)
+static thread_local JobQueue* t_pQueue = nullptr;
+
+
+//==================================================================
+// JobDeque
+//==================================================================
+
+//---------------------------------------------------------
+// Desc:   push a job at the bottom (only by the owner thread)
+// Ret:    false if the deque is full
+//---------------------------------------------------------
+bool JobDeque::Push(Job* pJob)
+{
+    const int64_t bottom = m_Bottom.load(std::memory_order_relaxed);
+    const int64_t top    = m_Top.load(std::memory_order_acquire);
+
+    if (bottom - top >= JOB_QUEUE_SIZE)
+        return false;
+
+    m_Jobs[bottom & (JOB_QUEUE_SIZE-1)].store(pJob, std::memory_order_relaxed);
+    m_Bottom.store(bottom + 1, std::memory_order_seq_cst);
+    return true;
+}
+
+//---------------------------------------------------------
+// Desc:   pop a job from the bottom (only by the owner thread);
+//         the last job is contended with thieves by CAS on the top
+//---------------------------------------------------------
+Job* JobDeque::Pop()
+{
+    const int64_t bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+    m_Bottom.store(bottom, std::memory_order_seq_cst);
+
+    int64_t top = m_Top.load(std::memory_order_seq_cst);
+
+    if (top > bottom)
+    {
+        // the deque is empty
+        m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    Job* pJob = m_Jobs[bottom & (JOB_QUEUE_SIZE-1)].load(std::memory_order_relaxed);
+
+    if (top == bottom)
+    {
+        if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst))
+            pJob = nullptr;     // a thief took it
+
+        m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    return pJob;
+}
+
+//---------------------------------------------------------
+// Desc:   steal a job from the top (by any thread)
+// Ret:    nullptr if the deque is empty or another thread won the race
+//---------------------------------------------------------
+Job* JobDeque::Steal()
+{
+    int64_t       top    = m_Top.load(std::memory_order_seq_cst);
+    const int64_t bottom = m_Bottom.load(std::memory_order_seq_cst);
+
+    if (top >= bottom)
+        return nullptr;
+
+    Job* pJob = m_Jobs[top & (JOB_QUEUE_SIZE-1)].load(std::memory_order_relaxed);
+
+    if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst))
+        return nullptr;
+
+    return pJob;
+}
+
+
+//==================================================================
+// JobSystem
+//==================================================================
+
+JobSystem::~JobSystem()
+{
+    Shutdown();
+
+    for (std::atomic<JobQueue*>& queue : m_Queues)
+        delete queue.exchange(nullptr);
+}
+
+//---------------------------------------------------------
+// Desc:   create worker threads
+// Args:   - numWorkers: how many threads to create
+//                       (if < 0 we use num of cores minus main thread)
+//---------------------------------------------------------
+void JobSystem::Initialize(const int numWorkers)
+{
+    Shutdown();
+
+    int count = numWorkers;
+
+    if (count < 0)
+    {
+        const int numCores = (int)std::thread::hardware_concurrency();
+        count = (numCores > 1) ? numCores - 1 : 0;
+    }
+
+    if (count > JOB_MAX_WORKERS)
+        count = JOB_MAX_WORKERS;
+
+    // queues of workers are kept after shutdown (they are empty then)
+    for (int i = 0; i < count; ++i)
+    {
+        if (!m_Queues[i].load())
+        {
+            JobQueue* pQueue = new JobQueue();
+            pQueue->rngState = 0x9E3779B9u * (i + 1);
+            m_Queues[i].store(pQueue);
+        }
+    }
+
+    m_Quit.store(false);
+    m_NumWorkers.store(count);
+    m_Threads.reserve(count);
+
+    for (int i = 0; i < count; ++i)
+        m_Threads.emplace_back(&JobSystem::WorkerLoop, this, i);
+
+    LogMsg(LOG, "job system is initialized (num workers: %d)", count);
+}
+
+//---------------------------------------------------------
+// Desc:   stop and join all the worker threads
+//         (all the submitted jobs must be waited before)
+//---------------------------------------------------------
+void JobSystem::Shutdown()
+{
+    if (m_Threads.empty())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Quit.store(true);
+    }
+    m_WakeCV.notify_all();
+
+    for (std::thread& t : m_Threads)
+        t.join();
+
+    m_Threads.clear();
+    m_NumWorkers.store(0);
+}
+
+//---------------------------------------------------------
+// Desc:   get a queue of the current thread; a thread which isn't
+//         a worker gets its queue when it submits a job for the first time
+// Ret:    nullptr if there are too many threads
+//---------------------------------------------------------
+JobQueue* JobSystem::GetThreadQueue()
+{
+    if (t_pQueue)
+        return t_pQueue;
+
+    const int idx = m_NumExternal.fetch_add(1, std::memory_order_acq_rel);
+
+    if (idx >= JOB_MAX_EXTERNAL)
+        return nullptr;
+
+    JobQueue* pQueue = new JobQueue();
+    pQueue->rngState = 0x85EBCA6Bu * (idx + 1);
+
+    m_Queues[JOB_MAX_WORKERS + idx].store(pQueue, std::memory_order_release);
+
+    t_pQueue = pQueue;
+    return pQueue;
+}
+
+//---------------------------------------------------------
+// Desc:   take the next job from the pool of the current thread
+// Ret:    nullptr if the job isn't free yet (too many jobs are in flight)
+//---------------------------------------------------------
+Job* JobSystem::AllocJob()
+{
+    JobQueue* pQueue = GetThreadQueue();
+
+    if (!pQueue || m_NumWorkers.load(std::memory_order_relaxed) == 0)
+        return nullptr;
+
+    Job& job = pQueue->jobs[pQueue->nextJob & (JOB_QUEUE_SIZE-1)];
+
+    if (job.isBusy.load(std::memory_order_acquire))
+        return nullptr;
+
+    pQueue->nextJob++;
+    job.isBusy.store(true, std::memory_order_relaxed);
+    return &job;
+}
+
+//---------------------------------------------------------
+// Desc:   push a job into the deque of the current thread and wake
+//         a sleeping worker (if the deque is full the job is executed now)
+//---------------------------------------------------------
+void JobSystem::PushJob(Job* pJob)
+{
+    m_NumQueued.fetch_add(1, std::memory_order_seq_cst);
+
+    if (!t_pQueue->deque.Push(pJob))
+    {
+        m_NumQueued.fetch_sub(1, std::memory_order_relaxed);
+        Execute(pJob);
+        return;
+    }
+
+    if (m_NumSleeping.load(std::memory_order_seq_cst) > 0)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_WakeCV.notify_one();
+    }
+}
+
+//---------------------------------------------------------
+// Desc:   take a job from the own deque or steal it from another thread
+//         (victims are checked starting from a random one)
+//---------------------------------------------------------
+Job* JobSystem::FindJob()
+{
+    JobQueue* pOwn = t_pQueue;
+    Job*      pJob = (pOwn) ? pOwn->deque.Pop() : nullptr;
+
+    if (!pJob)
+    {
+        const int numWorkers  = m_NumWorkers.load(std::memory_order_relaxed);
+        const int numExternal = m_NumExternal.load(std::memory_order_acquire);
+        const int numQueues   = numWorkers + ((numExternal < JOB_MAX_EXTERNAL) ? numExternal : JOB_MAX_EXTERNAL);
+
+        if (numQueues == 0)
+            return nullptr;
+
+        uint32_t start = 0;
+
+        if (pOwn)
+        {
+            // xorshift32
+            pOwn->rngState ^= pOwn->rngState << 13;
+            pOwn->rngState ^= pOwn->rngState >> 17;
+            pOwn->rngState ^= pOwn->rngState << 5;
+            start = pOwn->rngState;
+        }
+
+        for (int i = 0; i < numQueues && !pJob; ++i)
+        {
+            const int n      = (int)((start + i) % numQueues);
+            const int idx    = (n < numWorkers) ? n : JOB_MAX_WORKERS + (n - numWorkers);
+            JobQueue* pQueue = m_Queues[idx].load(std::memory_order_acquire);
+
+            if (pQueue && pQueue != pOwn)
+                pJob = pQueue->deque.Steal();
+        }
+    }
+
+    if (pJob)
+        m_NumQueued.fetch_sub(1, std::memory_order_relaxed);
+
+    return pJob;
+}
+
+//---------------------------------------------------------
+// Desc:   execute a job, free it and decrease its counter
+//---------------------------------------------------------
+void JobSystem::Execute(Job* pJob)
+{
+    pJob->pFunc(*pJob);
+
+    // the counter may be destroyed right after it gets zero so it's the last
+    JobCounter* pCounter = pJob->pCounter;
+    pJob->isBusy.store(false, std::memory_order_release);
+    pCounter->count.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+//---------------------------------------------------------
+// Desc:   wait until all the jobs of the counter are done;
+//         the calling thread executes jobs meanwhile
+//---------------------------------------------------------
+void JobSystem::Wait(JobCounter& counter)
+{
+    while (!counter.IsDone())
+    {
+        if (Job* pJob = FindJob())
+            Execute(pJob);
+        else
+            std::this_thread::yield();
+    }
+}
+
+//---------------------------------------------------------
+// Desc:   split items [0, numItems) into chunks and execute the input
+//         function for each chunk as a job (the calling thread works too);
+//         returns only when all the chunks are done
+// Args:   - numItems:  how many items to process
+//         - chunkSize: max number of items per chunk
+//         - func:      a function which is called for each chunk
+//---------------------------------------------------------
+void JobSystem::ParallelFor(
+    const int numItems,
+    const int chunkSize,
+    const ChunkFunc& func)
+{
+    if (numItems <= 0)
+        return;
+
+    const int size      = (chunkSize > 0) ? chunkSize : 1;
+    const int numChunks = GetNumChunks(numItems, size);
+
+    // no workers or nothing to split: just do it on this thread
+    if (m_NumWorkers.load(std::memory_order_relaxed) == 0 || numChunks == 1)
+    {
+        for (int i = 0; i < numChunks; ++i)
+        {
+            const int begin = i * size;
+            const int end   = (begin + size < numItems) ? begin + size : numItems;
+            func(i, begin, end);
+        }
+        return;
+    }
+
+    JobCounter counter;
+    const ChunkFunc* pFunc = &func;
+
+    for (int i = 0; i < numChunks; ++i)
+    {
+        const int begin = i * size;
+        const int end   = (begin + size < numItems) ? begin + size : numItems;
+
+        Submit(counter, [pFunc, i, begin, end]()
+        {
+            TRACE_ZONE("ParallelFor chunk");
+            (*pFunc)(i, begin, end);
+        });
+    }
+
+    Wait(counter);
+}
+
+//---------------------------------------------------------
+// Desc:   a loop of the worker thread: execute jobs while there are any,
+//         then spin a bit and sleep until a new job is pushed
+//---------------------------------------------------------
+void JobSystem::WorkerLoop(const int workerIdx)
+{
+    t_pQueue = m_Queues[workerIdx].load();
+    g_TraceRecorder.SetThreadName("worker");
+
+    int numIdle = 0;
+
+    while (!m_Quit.load(std::memory_order_relaxed))
+    {
+        if (Job* pJob = FindJob())
+        {
+            Execute(pJob);
+            numIdle = 0;
+            continue;
+        }
+
+        if (++numIdle < JOB_SPIN_COUNT)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_NumSleeping.fetch_add(1, std::memory_order_seq_cst);
+        m_WakeCV.wait(lock, [this]()
+        {
+            return m_Quit.load() || m_NumQueued.load(std::memory_order_seq_cst) > 0;
+        });
+        m_NumSleeping.fetch_sub(1, std::memory_order_relaxed);
+
+        numIdle = 0;
+    }
+}
@@ -0,0 +1,170 @@
+// ==================================================================
+// Filename:    JobSystem.h
+// Description: a work-stealing job system:
+//              - each worker thread (and each other thread which submits
+//                jobs) has its own deque of jobs: the owner pushes and pops
+//                jobs at the bottom, idle threads steal from the top
+//                of the others' deques (lock-free)
+//              - jobs are taken from a per-thread pool: a small callable
+//                is copied into the job, so there are no allocations
+//              - dependencies: each job decrements its counter when it is
+//                done; Wait() on the counter executes other jobs meanwhile
+//                (so it can be called from inside of a job as well)
+//              - ParallelFor() splits a range into chunks jobs
+//              - if there is no free job or the deque is full the job
+//                is just executed right away by the calling thread
+//
+//              usage:
+//                JobCounter counter;
+//                g_JobSystem.Submit(counter, [&]() { LoadA(); });
+//                g_JobSystem.Submit(counter, [&]() { LoadB(); });
+//                g_JobSystem.Wait(counter);
+//
+// Created:     19.10.2026 by DimaSkup
+// ==================================================================
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <vector>
+#include <stdint.h>
+
+constexpr int JOB_MAX_WORKERS   = 64;
+constexpr int JOB_MAX_EXTERNAL  = 8;        // max threads which aren't workers but submit jobs (main, etc.)
+constexpr int JOB_QUEUE_SIZE    = 4096;     // jobs per deque and per pool (power of 2)
+constexpr int JOB_DATA_SIZE     = 48;       // max size of callable which is stored in the job
+
+// a task over items range [begin, end) which belongs to chunk by index
+using ChunkFunc = std::function<void(const int chunkIdx, const int begin, const int end)>;
+
+// a number of jobs which aren't done yet (a fence to wait on)
+struct JobCounter
+{
+    std::atomic<int> count{0};
+
+    inline bool IsDone() const { return count.load(std::memory_order_acquire) == 0; }
+};
+
+struct Job
+{
+    void             (*pFunc)(Job& job) = nullptr;     // calls the stored callable
+    JobCounter*        pCounter = nullptr;
+    std::atomic<bool>  isBusy{false};                  // the job is submitted and isn't done
+    alignas(16) char   data[JOB_DATA_SIZE];
+};
+
+// ==================================================================
+// a fixed size deque of jobs (Chase-Lev): only the owner thread
+// pushes/pops at the bottom, any thread can steal from the top
+// ==================================================================
+class JobDeque
+{
+public:
+    bool Push(Job* pJob);
+    Job* Pop();
+    Job* Steal();
+
+private:
+    std::atomic<int64_t> m_Top{0};
+    std::atomic<int64_t> m_Bottom{0};
+    std::atomic<Job*>    m_Jobs[JOB_QUEUE_SIZE];
+};
+
+// a deque and a pool of jobs of one thread
+struct JobQueue
+{
+    JobDeque deque;
+    Job      jobs[JOB_QUEUE_SIZE];
+    uint32_t nextJob = 0;                   // the pool is used as a ring
+    uint32_t rngState = 0;                  // to choose a victim to steal from
+};
+
+///////////////////////////////////////////////////////////
+
+class JobSystem
+{
+public:
+    JobSystem() {}
+    ~JobSystem();
+
+    void Initialize(const int numWorkers = -1);
+    void Shutdown();
+
+    //-----------------------------------------------------
+    // Desc:   submit a job which calls the input callable; the callable
+    //         is copied into the job so it must be small and trivially
+    //         copyable (for instance, a lambda which captures refs/ptrs)
+    // Args:   - counter:  is increased now and decreased when the job is done
+    //         - func:     a callable: void()
+    //-----------------------------------------------------
+    template <typename Func>
+    void Submit(JobCounter& counter, const Func& func)
+    {
+        static_assert(sizeof(Func) <= JOB_DATA_SIZE, "a job callable is too big");
+        static_assert(alignof(Func) <= 16, "a job callable is over-aligned");
+        static_assert(std::is_trivially_copyable<Func>::value, "a job callable must be trivially copyable");
+
+        Job* pJob = AllocJob();
+
+        if (!pJob)
+        {
+            func();
+            return;
+        }
+
+        new (pJob->data) Func(func);
+        pJob->pFunc    = [](Job& job) { (*reinterpret_cast<Func*>(job.data))(); };
+        pJob->pCounter = &counter;
+
+        counter.count.fetch_add(1, std::memory_order_relaxed);
+        PushJob(pJob);
+    }
+
+    void Wait(JobCounter& counter);
+
+    void ParallelFor(
+        const int numItems,
+        const int chunkSize,
+        const ChunkFunc& func);
+
+    inline int GetNumWorkers() const { return m_NumWorkers.load(std::memory_order_relaxed); }
+
+    inline static int GetNumChunks(const int numItems, const int chunkSize)
+    {   return (numItems + chunkSize - 1) / chunkSize;   }
+
+private:
+    JobQueue* GetThreadQueue();
+    Job*      AllocJob();
+    void      PushJob(Job* pJob);
+    Job*      FindJob();
+    void      Execute(Job* pJob);
+    void      WorkerLoop(const int workerIdx);
+
+private:
+    std::vector<std::thread> m_Threads;
+    std::atomic<int>         m_NumWorkers{0};
+
+    // queues of workers: [0, JOB_MAX_WORKERS), of other threads: the rest
+    std::atomic<JobQueue*>   m_Queues[JOB_MAX_WORKERS + JOB_MAX_EXTERNAL];
+    std::atomic<int>         m_NumExternal{0};
+
+    // sleeping of idle workers
+    std::mutex               m_Mutex;
+    std::condition_variable  m_WakeCV;
+    std::atomic<int>         m_NumQueued{0};        // jobs in all the deques
+    std::atomic<int>         m_NumSleeping{0};
+    std::atomic<bool>        m_Quit{false};
+};
+
+// ==================================================================
+// Declare a global instance of the job system
+// ==================================================================
+extern JobSystem g_JobSystem;
+
+#endif
@@ -1,17 +1,46 @@
 // ==================================================================
 // Filename:    log.cpp
-// Description: implementation of logger
+// Description: implementation of logger:
+//              - a caller doesn't format a message and doesn't write
+//                anything: it only copies the format string ptr and
+//                arguments into the ring buffer of its thread
+//                (lock-free: one writer, one reader)
+//              - if the ring is full the message is dropped (the caller
+//                never waits), the number of dropped messages is logged later
+//              - a background thread takes messages from all the rings
+//                in order of their sequence numbers, formats and writes them
+//                into the console and the log file
+//
+//              NOTE: format strings must be string literals since
+//                    they are formatted later
 //
 // Created:     07.04.2025 by DimaSkup
 // ==================================================================
 #include "Log.h"
+#include "LogFormat.h"
 #include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
 #include <time.h>
 #include <stdarg.h>
 #include <string.h>
+#include <strings.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 
 #define BUF_SIZE 512
 
+constexpr int      LOG_MAX_THREADS   = 32;
+constexpr uint32_t LOG_RING_SIZE     = 1 << 16;   // bytes per thread (power of 2)
+constexpr int      LOG_MAX_RECORD    = 1024;      // max size of one message in the ring
+constexpr int      LOG_IDLE_SLEEP_MS = 5;         // the flush thread sleeps when there is nothing to write
+constexpr int      LOG_MAX_CATEGORIES = 64;
+constexpr int      LOG_MAX_CATEGORY_NAME = 32;
+
 // static ptr to the logger file
 FILE* s_pLogFile = NULL;
 
@@ -22,42 +51,743 @@ char g_String[BUF_SIZE]{'\0'};
 char s_StrTempBuf[BUF_SIZE]{'\0'};
 
 
+// a header of record; it is followed by captured arguments
+struct LogRecord
+{
+    uint32_t       size     = 0;        // the whole record in bytes (aligned by 8)
+    uint32_t       argsSize = 0;        // captured arguments after the header
+    eLogRecordType type     = LOG_RECORD_PLAIN;
+    uint64_t       seq      = 0;        // the global order of messages
+    long           clock    = 0;
+    const char*    fileName = nullptr;
+    const char*    funcName = nullptr;
+    const char*    format   = nullptr;  // or a color code
+    int            codeLine = 0;
+};
+
+// a ring buffer of one thread: the thread writes, the flush thread reads
+struct LogRing
+{
+    char                  data[LOG_RING_SIZE];
+    std::atomic<uint32_t> head{0};           // write position
+    std::atomic<uint32_t> tail{0};           // read position
+    std::atomic<uint32_t> numDropped{0};
+};
+
+static std::atomic<LogRing*> s_Rings[LOG_MAX_THREADS];
+static std::atomic<int>      s_NumRings{0};
+static std::atomic<uint64_t> s_Seq{0};
+static std::atomic<uint32_t> s_NumDroppedNoRing{0};    // threads over LOG_MAX_THREADS
+static thread_local LogRing* t_pRing = nullptr;
+
+// the flush thread
+static std::thread             s_FlushThread;
+static std::atomic<bool>       s_IsRunning{false};
+static std::atomic<bool>       s_StopFlush{false};
+static std::mutex              s_FlushMutex;
+static std::condition_variable s_FlushCV;
+
+static void FlushLoop();
+static bool WriteRecords();
+
+// the binary log: it is written only by the flush thread;
+// IDs of sites are assigned when a site is met for the first time
+struct BinSiteKey
+{
+    const char* format   = nullptr;
+    const char* fileName = nullptr;
+    int         codeLine = 0;
+
+    bool operator==(const BinSiteKey& rhs) const
+    {
+        return (format == rhs.format) && (fileName == rhs.fileName) && (codeLine == rhs.codeLine);
+    }
+};
+
+struct BinSiteKeyHash
+{
+    size_t operator()(const BinSiteKey& key) const
+    {
+        return std::hash<const void*>()(key.format) ^ (std::hash<const void*>()(key.fileName) * 31) ^ (size_t)key.codeLine;
+    }
+};
+
+static std::atomic<FILE*>                                       s_pBinFile{nullptr};
+static std::unordered_map<BinSiteKey, uint32_t, BinSiteKeyHash> s_BinSites;
+
+// levels of categories (-1: the global level is used)
+static std::atomic<int>  s_GlobalLevel{LOG_LEVEL_DEBUG};
+static std::atomic<int>  s_CategoryLevels[LOG_MAX_CATEGORIES];
+static char              s_CategoryNames[LOG_MAX_CATEGORIES][LOG_MAX_CATEGORY_NAME];
+static int               s_NumCategories = 0;
+static std::mutex        s_CategoryMutex;           // categories and sites are added under it
+static LogSite*          s_pSites = nullptr;
+
+
+//==================================================================
+// ring buffers
+//==================================================================
+
 //---------------------------------------------------------
-// Desc:   set console color to some particular by input code
-// Args:   - keyColor: key code to change color
+// Desc:   get a ring of the current thread or register a new one
 //---------------------------------------------------------
-void SetConsoleColor(const char* keyColor)
+static LogRing* GetThreadRing()
 {
-    printf("%s", keyColor);
+    if (t_pRing)
+        return t_pRing;
+
+    const int idx = s_NumRings.fetch_add(1, std::memory_order_relaxed);
+
+    if (idx >= LOG_MAX_THREADS)
+        return nullptr;
+
+    LogRing* pRing = new LogRing();
+    s_Rings[idx].store(pRing, std::memory_order_release);
+    t_pRing = pRing;
+
+    return pRing;
+}
+
+//---------------------------------------------------------
+// Desc:   copy bytes into the ring / from the ring (with wrapping)
+//---------------------------------------------------------
+static void RingWrite(LogRing& ring, const uint32_t pos, const void* pData, const uint32_t size)
+{
+    const uint32_t offset = pos & (LOG_RING_SIZE-1);
+    const uint32_t first  = (size < LOG_RING_SIZE - offset) ? size : LOG_RING_SIZE - offset;
+
+    memcpy(ring.data + offset, pData, first);
+    memcpy(ring.data, (const char*)pData + first, size - first);
+}
+
+static void RingRead(const LogRing& ring, const uint32_t pos, void* pData, const uint32_t size)
+{
+    const uint32_t offset = pos & (LOG_RING_SIZE-1);
+    const uint32_t first  = (size < LOG_RING_SIZE - offset) ? size : LOG_RING_SIZE - offset;
+
+    memcpy(pData, ring.data + offset, first);
+    memcpy((char*)pData + first, ring.data, size - first);
 }
 
 //---------------------------------------------------------
-// Desc:   a helper for printing messages into the console
-//         and into the logger file
-// Args:   - fileName:  path to the caller file
-//         - funcName:  name of the caller function/method
-//         - type:      type of the log message
-//         - text:      log message content
-//         - codeLine:  line of code where logger was called
+// Desc:   put a record into the ring of the current thread
+//         (if there is no space the record is dropped)
 //---------------------------------------------------------
-void PrintHelper(
+static void PushRecord(
+    const eLogRecordType type,
     const char* fileName,
     const char* funcName,
-    const char* type,
-    const char* text,
-    const int codeLine)
+    const int codeLine,
+    const char* format,
+    va_list* pArgs)
+{
+    LogRing* pRing = GetThreadRing();
+
+    if (!pRing)
+    {
+        s_NumDroppedNoRing.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    alignas(8) char buf[LOG_MAX_RECORD];
+
+    LogRecord rec;
+    rec.type     = type;
+    rec.clock    = (long)clock();
+    rec.fileName = fileName;
+    rec.funcName = funcName;
+    rec.format   = format;
+    rec.codeLine = codeLine;
+
+    LogArgWriter w;
+    w.pBuf = buf;
+    w.pos  = sizeof(LogRecord);
+    w.size = LOG_MAX_RECORD;
+
+    if (pArgs && !LogCaptureArgs(format, *pArgs, w))
+    {
+        pRing->numDropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    rec.argsSize = (uint32_t)(w.pos - sizeof(LogRecord));
+    rec.size     = (uint32_t)(w.pos + 7) & ~7u;
+    rec.seq      = s_Seq.fetch_add(1, std::memory_order_relaxed);
+    memcpy(buf, &rec, sizeof(rec));
+
+    const uint32_t head = pRing->head.load(std::memory_order_relaxed);
+    const uint32_t tail = pRing->tail.load(std::memory_order_acquire);
+
+    if (LOG_RING_SIZE - (head - tail) < rec.size)
+    {
+        pRing->numDropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    RingWrite(*pRing, head, buf, rec.size);
+    pRing->head.store(head + rec.size, std::memory_order_release);
+}
+
+//---------------------------------------------------------
+// Desc:   print a formatted record into the console and into the log file
+//---------------------------------------------------------
+static void PrintRecord(const LogRecord& rec, const char* text)
 {
-    const char* fmt = "[%05ld] %s %s: %s() (line: %d): %s\n";
-    const time_t t = clock();
+    const char* fmt  = "[%05ld] %s %s: %s() (line: %d): %s\n";
+    const char* type = "";
+
+    switch (rec.type)
+    {
+        case LOG_RECORD_COLOR:
+            printf("%s", rec.format);
+            return;
+
+        case LOG_RECORD_PLAIN:
+            printf("[%05ld] %s\n", rec.clock, text);
+            if (s_pLogFile)
+                fprintf(s_pLogFile, "[%05ld] %s\n", rec.clock, text);
+            return;
+
+        case LOG_RECORD_MSG:
+            printf("%s", GREEN);
+            break;
+
+        case LOG_RECORD_DBG:
+            printf("%s", RESET);
+            type = "DEBUG:";
+            break;
+
+        case LOG_RECORD_ERR:
+            printf("%s", RED);
+            type = "ERROR:";
+            break;
+    }
 
-    printf(fmt, t, type, fileName, funcName, codeLine, text);
+    printf(fmt, rec.clock, type, rec.fileName, rec.funcName, rec.codeLine, text);
 
     if (s_pLogFile)
-        fprintf(s_pLogFile, fmt, t, type, fileName, funcName, codeLine, text);
+        fprintf(s_pLogFile, fmt, rec.clock, type, rec.fileName, rec.funcName, rec.codeLine, text);
+
+    if (rec.type != LOG_RECORD_DBG)
+        printf("%s", RESET);
+}
+
+//---------------------------------------------------------
+// Desc:   write a string into the binary log (u16 length + chars)
+//---------------------------------------------------------
+static void BinWriteStr(FILE* pFile, const char* str)
+{
+    const size_t   len  = (str) ? strlen(str) : 0;
+    const uint16_t len16 = (uint16_t)((len < UINT16_MAX) ? len : UINT16_MAX);
+
+    fwrite(&len16, sizeof(len16), 1, pFile);
+    fwrite(str, 1, len16, pFile);
+}
+
+//---------------------------------------------------------
+// Desc:   write a record into the binary log: its site is written
+//         only once, then only the site ID, time and raw arguments
+//---------------------------------------------------------
+static void WriteBinRecord(FILE* pFile, const LogRecord& rec, const char* pArgs, const uint32_t argsSize)
+{
+    BinSiteKey key;
+    key.format   = rec.format;
+    key.fileName = rec.fileName;
+    key.codeLine = rec.codeLine;
+
+    auto it = s_BinSites.find(key);
+
+    if (it == s_BinSites.end())
+    {
+        const uint32_t id   = (uint32_t)s_BinSites.size();
+        const uint8_t  tag  = LOG_BIN_SITE;
+        const uint8_t  type = (uint8_t)rec.type;
+        const int32_t  line = rec.codeLine;
+
+        it = s_BinSites.insert({ key, id }).first;
+
+        fwrite(&tag,  sizeof(tag),  1, pFile);
+        fwrite(&id,   sizeof(id),   1, pFile);
+        fwrite(&type, sizeof(type), 1, pFile);
+        fwrite(&line, sizeof(line), 1, pFile);
+        BinWriteStr(pFile, rec.fileName);
+        BinWriteStr(pFile, rec.funcName);
+        BinWriteStr(pFile, rec.format);
+    }
+
+    char         buf[16];
+    LogArgWriter w;
+    w.pBuf = buf;
+    w.size = sizeof(buf);
+
+    w.Write((uint8_t)LOG_BIN_MSG);
+    w.Write(it->second);
+    w.Write((int64_t)rec.clock);
+    w.Write((uint16_t)argsSize);
+
+    fwrite(buf, 1, w.pos, pFile);
+    fwrite(pArgs, 1, argsSize, pFile);
+}
+
+//---------------------------------------------------------
+// Desc:   write a record which is taken from a ring:
+//         - text mode: format and print it into the console and log file
+//         - binary mode: write it as is into the binary log
+//           (errors are printed as text as well so they are seen)
+//---------------------------------------------------------
+static void OutputRecord(const LogRecord& rec, const char* pArgs, const uint32_t argsSize)
+{
+    FILE* pBinFile = s_pBinFile.load(std::memory_order_acquire);
+
+    if (pBinFile && rec.type != LOG_RECORD_COLOR)
+    {
+        WriteBinRecord(pBinFile, rec, pArgs, argsSize);
+
+        if (rec.type != LOG_RECORD_ERR)
+            return;
+    }
+
+    char text[BUF_SIZE];
+    text[0] = '\0';
+
+    if (rec.type != LOG_RECORD_COLOR)
+    {
+        LogArgReader r;
+        r.pBuf = pArgs;
+        r.size = (int)argsSize;
+
+        LogFormatArgs(rec.format, r, text, sizeof(text));
+    }
+
+    PrintRecord(rec, text);
+}
+
+//---------------------------------------------------------
+// Desc:   write a message of the logger itself (from the flush thread)
+//---------------------------------------------------------
+static void OutputInternal(const char* format, ...)
+{
+    alignas(8) char buf[LOG_MAX_RECORD];
+
+    LogRecord rec;
+    rec.type   = LOG_RECORD_PLAIN;
+    rec.clock  = (long)clock();
+    rec.format = format;
+
+    LogArgWriter w;
+    w.pBuf = buf;
+    w.size = sizeof(buf);
+
+    va_list args;
+    va_start(args, format);
+    LogCaptureArgs(format, args, w);
+    va_end(args);
+
+    OutputRecord(rec, buf, (uint32_t)w.pos);
+}
+
+//---------------------------------------------------------
+// Desc:   write all the records which are in the rings now;
+//         records of different threads are written in order of
+//         their sequence numbers
+// Ret:    true if something was written
+//---------------------------------------------------------
+static bool WriteRecords()
+{
+    alignas(8) char buf[LOG_MAX_RECORD];
+    bool            isWritten = false;
+
+    const int numRings = s_NumRings.load(std::memory_order_acquire);
+
+    // report dropped messages
+    for (int i = 0; i < numRings && i < LOG_MAX_THREADS; ++i)
+    {
+        LogRing* pRing = s_Rings[i].load(std::memory_order_acquire);
+        const uint32_t numDropped = pRing ? pRing->numDropped.exchange(0, std::memory_order_relaxed) : 0;
+
+        if (numDropped > 0)
+            OutputInternal("logger: %u messages of thread %d are dropped (the ring is full)", numDropped, i);
+    }
+
+    const uint32_t numDroppedNoRing = s_NumDroppedNoRing.exchange(0, std::memory_order_relaxed);
+
+    if (numDroppedNoRing > 0)
+        OutputInternal("logger: %u messages are dropped (too many threads)", numDroppedNoRing);
+
+    while (true)
+    {
+        // find the oldest record among the rings
+        LogRing*  pBest = nullptr;
+        LogRecord best;
+
+        for (int i = 0; i < numRings && i < LOG_MAX_THREADS; ++i)
+        {
+            LogRing* pRing = s_Rings[i].load(std::memory_order_acquire);
+
+            if (!pRing)
+                continue;
+
+            const uint32_t tail = pRing->tail.load(std::memory_order_relaxed);
+            const uint32_t head = pRing->head.load(std::memory_order_acquire);
+
+            if (tail == head)
+                continue;
+
+            LogRecord rec;
+            RingRead(*pRing, tail, &rec, sizeof(rec));
+
+            if (!pBest || rec.seq < best.seq)
+            {
+                pBest = pRing;
+                best  = rec;
+            }
+        }
+
+        if (!pBest)
+            break;
+
+        const uint32_t tail = pBest->tail.load(std::memory_order_relaxed);
+        RingRead(*pBest, tail, buf, best.size);
+        pBest->tail.store(tail + best.size, std::memory_order_release);
+
+        OutputRecord(best, buf + sizeof(LogRecord), best.argsSize);
+        isWritten = true;
+    }
+
+    return isWritten;
+}
+
+//---------------------------------------------------------
+// Desc:   the loop of the flush thread: write records until the logger is
+//         closed (then the rest records are written)
+//---------------------------------------------------------
+static void FlushLoop()
+{
+    while (!s_StopFlush.load(std::memory_order_acquire))
+    {
+        if (WriteRecords())
+        {
+            fflush(stdout);
+
+            if (FILE* pBinFile = s_pBinFile.load(std::memory_order_acquire))
+                fflush(pBinFile);
+
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(s_FlushMutex);
+        s_FlushCV.wait_for(lock, std::chrono::milliseconds(LOG_IDLE_SLEEP_MS));
+    }
+
+    WriteRecords();
+    fflush(stdout);
+}
+
+//---------------------------------------------------------
+// Desc:   stop the flush thread (all the records are written before)
+//---------------------------------------------------------
+static void StopFlushThread()
+{
+    if (!s_IsRunning.exchange(false))
+        return;
+
+    s_StopFlush.store(true, std::memory_order_release);
+    s_FlushCV.notify_one();
+    s_FlushThread.join();
+}
+
+//---------------------------------------------------------
+// Desc:   format and print a message right in the calling thread
+//         (when the flush thread isn't running: before InitLogger
+//         or after CloseLogger)
+//---------------------------------------------------------
+static void PrintSync(
+    const eLogRecordType type,
+    const char* fileName,
+    const char* funcName,
+    const int codeLine,
+    const char* format,
+    va_list* pArgs)
+{
+    LogRecord rec;
+    rec.type     = type;
+    rec.clock    = (long)clock();
+    rec.fileName = fileName;
+    rec.funcName = funcName;
+    rec.format   = format;
+    rec.codeLine = codeLine;
+
+    // reset the buffer
+    memset(s_StrTempBuf, 0, BUF_SIZE);
+
+    // make a string with input log-message
+    if (pArgs)
+        vsnprintf(s_StrTempBuf, BUF_SIZE-1, format, *pArgs);
+
+    PrintRecord(rec, s_StrTempBuf);
+}
+
+//---------------------------------------------------------
+// Desc:   pass a message to the flush thread or print it right now
+//---------------------------------------------------------
+static void Log(
+    const eLogRecordType type,
+    const char* fileName,
+    const char* funcName,
+    const int codeLine,
+    const char* format,
+    va_list* pArgs)
+{
+    if (s_IsRunning.load(std::memory_order_acquire))
+        PushRecord(type, fileName, funcName, codeLine, format, pArgs);
+    else
+        PrintSync(type, fileName, funcName, codeLine, format, pArgs);
+}
+
+
+//==================================================================
+// levels and rate limiting
+//==================================================================
+
+//---------------------------------------------------------
+// Desc:   get a type of record by a level of message
+//---------------------------------------------------------
+static eLogRecordType GetRecordType(const int level)
+{
+    switch (level)
+    {
+        case LOG_LEVEL_DEBUG:   return LOG_RECORD_DBG;
+        case LOG_LEVEL_ERR:     return LOG_RECORD_ERR;
+        default:                return LOG_RECORD_MSG;
+    }
+}
+
+//---------------------------------------------------------
+// Desc:   a helper to log a message of the logger itself
+//---------------------------------------------------------
+static void LogInternal(
+    const eLogRecordType type,
+    const char* fileName,
+    const char* funcName,
+    const int codeLine,
+    const char* format,
+    ...)
+{
+    va_list args;
+    va_start(args, format);
+    Log(type, fileName, funcName, codeLine, format, &args);
+    va_end(args);
+}
+
+//---------------------------------------------------------
+// Desc:   find a category by name or add a new one (under the category mutex)
+// Args:   - name:  a category name
+//         - len:   the name length (the name isn't null-terminated
+//                  when it is a part of file path)
+// Ret:    an index of the category or -1 if there are too many categories
+//---------------------------------------------------------
+static int GetCategory(const char* name, const int len)
+{
+    if (len >= LOG_MAX_CATEGORY_NAME)
+        return -1;
+
+    for (int i = 0; i < s_NumCategories; ++i)
+    {
+        if (strncasecmp(s_CategoryNames[i], name, len) == 0 && s_CategoryNames[i][len] == '\0')
+            return i;
+    }
+
+    if (s_NumCategories == LOG_MAX_CATEGORIES)
+        return -1;
+
+    const int idx = s_NumCategories++;
+
+    strncpy(s_CategoryNames[idx], name, len);
+    s_CategoryNames[idx][len] = '\0';
+    s_CategoryLevels[idx].store(-1, std::memory_order_relaxed);
+
+    return idx;
+}
+
+//---------------------------------------------------------
+// Desc:   register a call site: its category is the name
+//         of the source file ("./src/Render.cpp" -> "Render")
+//---------------------------------------------------------
+LogSite::LogSite(const char* fileName_, const char* funcName_, const int codeLine_, const int level_) :
+    fileName(fileName_),
+    funcName(funcName_),
+    codeLine(codeLine_),
+    level(level_)
+{
+    const char* name = fileName;
+
+    for (const char* p = fileName; *p; ++p)
+    {
+        if (*p == '/' || *p == '\\')
+            name = p + 1;
+    }
+
+    const char* ext = strchr(name, '.');
+    const int   len = ext ? (int)(ext - name) : (int)strlen(name);
+
+    std::lock_guard<std::mutex> lock(s_CategoryMutex);
+
+    category = GetCategory(name, len);
+    pNext    = s_pSites;
+    s_pSites = this;
+}
+
+//---------------------------------------------------------
+// Desc:   set the level of all the categories which don't have their own
+//---------------------------------------------------------
+void SetLogLevel(const int level)
+{
+    s_GlobalLevel.store(level, std::memory_order_relaxed);
+}
+
+//---------------------------------------------------------
+// Desc:   set the level of messages of the category
+//         (a name of the source file, case insensitive)
+//---------------------------------------------------------
+void SetLogCategoryLevel(const char* category, const int level)
+{
+    std::lock_guard<std::mutex> lock(s_CategoryMutex);
+
+    const int idx = GetCategory(category, (int)strlen(category));
+
+    if (idx == -1)
+    {
+        printf("logger: can't add a log category: %s\n", category);
+        return;
+    }
+
+    s_CategoryLevels[idx].store(level, std::memory_order_relaxed);
+}
+
+//---------------------------------------------------------
+// Desc:   set levels by a string (command line): a comma separated list
+//         of "<level>" or "<category>:<level>" where the level is one of:
+//         debug, msg, err, none
+// Ret:    false if the string is invalid
+//---------------------------------------------------------
+bool SetLogLevels(const char* levels)
+{
+    const char* names[] = { "debug", "msg", "err", "none" };
+    char        item[LOG_MAX_CATEGORY_NAME * 2];
+
+    while (*levels)
+    {
+        const char* end = strchr(levels, ',');
+        const int   len = end ? (int)(end - levels) : (int)strlen(levels);
+
+        if (len == 0 || len >= (int)sizeof(item))
+            return false;
+
+        strncpy(item, levels, len);
+        item[len] = '\0';
+
+        char*       colon     = strchr(item, ':');
+        const char* levelName = colon ? colon + 1 : item;
+        int         level     = -1;
+
+        for (int i = 0; i < 4; ++i)
+        {
+            if (strcasecmp(levelName, names[i]) == 0)
+                level = i;
+        }
+
+        if (level == -1)
+            return false;
+
+        if (colon)
+        {
+            *colon = '\0';
+            SetLogCategoryLevel(item, level);
+        }
+        else
+        {
+            SetLogLevel(level);
+        }
+
+        levels += (end) ? len + 1 : len;
+    }
+
+    return true;
+}
+
+//---------------------------------------------------------
+// Desc:   check if a message of the call site must be logged:
+//         its level is enough and the site isn't over the rate limit
+//         (the number of suppressed messages is logged when
+//         the next period starts)
+//---------------------------------------------------------
+bool LogSiteFilter(LogSite& site)
+{
+    int minLevel = (site.category != -1) ? s_CategoryLevels[site.category].load(std::memory_order_relaxed) : -1;
+
+    if (minLevel == -1)
+        minLevel = s_GlobalLevel.load(std::memory_order_relaxed);
+
+    if (site.level < minLevel)
+        return false;
+
+    const int64_t nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+
+    int64_t startMs = site.periodStartMs.load(std::memory_order_relaxed);
+
+    // only one thread starts a new period
+    if (nowMs - startMs >= LOG_RATE_PERIOD_MS &&
+        site.periodStartMs.compare_exchange_strong(startMs, nowMs, std::memory_order_relaxed))
+    {
+        site.numInPeriod.store(0, std::memory_order_relaxed);
+        const uint32_t numSuppressed = site.numSuppressed.exchange(0, std::memory_order_relaxed);
+
+        if (numSuppressed > 0)
+            LogInternal(GetRecordType(site.level), site.fileName, site.funcName, site.codeLine, "message repeated %u times", numSuppressed);
+    }
+
+    if (site.numInPeriod.fetch_add(1, std::memory_order_relaxed) < LOG_RATE_MAX_MSGS)
+        return true;
+
+    site.numSuppressed.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+//---------------------------------------------------------
+// Desc:   log the number of suppressed messages of all the sites
+//         (the rest of the last periods)
+//---------------------------------------------------------
+static void ReportSuppressed()
+{
+    std::lock_guard<std::mutex> lock(s_CategoryMutex);
+
+    for (LogSite* pSite = s_pSites; pSite; pSite = pSite->pNext)
+    {
+        const uint32_t numSuppressed = pSite->numSuppressed.exchange(0, std::memory_order_relaxed);
+
+        if (numSuppressed > 0)
+            LogInternal(GetRecordType(pSite->level), pSite->fileName, pSite->funcName, pSite->codeLine, "message repeated %u times", numSuppressed);
+    }
+}
+
+
+//==================================================================
+// public functions
+//==================================================================
+
+//---------------------------------------------------------
+// Desc:   set console color to some particular by input code
+// Args:   - keyColor: key code to change color
+//---------------------------------------------------------
+void SetConsoleColor(const char* keyColor)
+{
+    Log(LOG_RECORD_COLOR, nullptr, nullptr, 0, keyColor, nullptr);
 }
 
 //---------------------------------------------------------
 // Desc:   create a logger file into which we will write messages
+//         and start the flush thread
 // Ret:    1 if everything is OK, and 0 if something went wrong
 //---------------------------------------------------------
 int InitLogger(void)
@@ -79,6 +809,14 @@ int InitLogger(void)
         fprintf(s_pLogFile, "%s| the log file is create!\n", buffer);
         fprintf(s_pLogFile, "-------------------------\n\n");
 
+        // messages are written by the background thread from now on;
+        // (if the program calls exit() the rest messages are written anyway)
+        s_StopFlush.store(false);
+        s_FlushThread = std::thread(FlushLoop);
+        s_IsRunning.store(true, std::memory_order_release);
+
+        atexit(StopFlushThread);
+
         return 1;
     }
     else
@@ -89,10 +827,22 @@ int InitLogger(void)
 }
 
 //---------------------------------------------------------
-// Desc:   print msg about closing of the log file and close it
+// Desc:   write the rest messages, print msg about closing
+//         of the log file and close it
 //---------------------------------------------------------
 void CloseLogger(void)
 {
+    ReportSuppressed();
+    StopFlushThread();
+
+    FILE* pBinFile = s_pBinFile.exchange(nullptr);
+
+    if (pBinFile)
+        fclose(pBinFile);
+
+    if (!s_pLogFile)
+        return;
+
     time_t rawTime;
     struct tm* info = NULL;
     char buffer[80];
@@ -102,37 +852,56 @@ void CloseLogger(void)
     strftime(buffer, 80, "%x -%I:%M%p", info);
 
     fprintf(s_pLogFile, "\n--------------------------------\n");
-    fprintf(s_pLogFile, "%s| this is the end, my only friend, the end\n");
+    fprintf(s_pLogFile, "%s| this is the end, my only friend, the end\n", buffer);
 
     fclose(s_pLogFile);
+    s_pLogFile = NULL;
 }
 
 //---------------------------------------------------------
-// Desc:   print a usual message into console but without
-//         info about the caller
-// Args:   - format:   format string for variadic aruments
-//         - ...:      variadic arguments
+// Desc:   write messages into a binary log file from now on instead
+//         of text (it is turned into text by the log_decoder tool)
+// Ret:    false if the file can't be created
 //---------------------------------------------------------
-void LogMsg(const char* format, ...)
+bool SetLogBinaryFile(const char* filename)
 {
-    va_list args;
-    va_start(args, format);
+    FILE* pFile = fopen(filename, "wb");
 
-    // reset the buffer
-    memset(s_StrTempBuf, 0, BUF_SIZE);
+    if (!pFile)
+    {
+        LogErr(LOG, "can't create a binary log file: %s", filename);
+        return false;
+    }
 
-    // make a string with input log-message
-    vsnprintf(s_StrTempBuf, BUF_SIZE-1, format, args);
+    const uint32_t clocksPerSec = CLOCKS_PER_SEC;
 
-    // print a message into the console and log-file
-    const char* fmt = "[%05ld] %s\n";
-    const time_t t = clock();
+    fwrite(LOG_BIN_MAGIC, 1, sizeof(LOG_BIN_MAGIC), pFile);
+    fwrite(&clocksPerSec, sizeof(clocksPerSec), 1, pFile);
 
-    printf(fmt, t, s_StrTempBuf);
+    FILE* pNoFile = nullptr;
 
-    if (s_pLogFile)
-        fprintf(s_pLogFile, fmt, t, s_StrTempBuf);
+    if (!s_pBinFile.compare_exchange_strong(pNoFile, pFile, std::memory_order_acq_rel))
+    {
+        LogErr(LOG, "the binary log file is already set");
+        fclose(pFile);
+        return false;
+    }
 
+    LogMsg(LOG, "messages are written into the binary log: %s", filename);
+    return true;
+}
+
+//---------------------------------------------------------
+// Desc:   print a usual message into console but without
+//         info about the caller
+// Args:   - format:   format string for variadic aruments
+//         - ...:      variadic arguments
+//---------------------------------------------------------
+void LogMsgImpl(const char* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    Log(LOG_RECORD_PLAIN, nullptr, nullptr, 0, format, &args);
     va_end(args);
 }
 
@@ -144,7 +913,7 @@ void LogMsg(const char* format, ...)
 //         - format:     format string for variadic arguments
 //         - ...:        variadic arguments
 //---------------------------------------------------------
-void LogMsg(
+void LogMsgImpl(
     const char* fileName,
     const char* funcName,
     const int codeLine,
@@ -153,18 +922,7 @@ void LogMsg(
 {
     va_list args;
     va_start(args, format);
-
-    // reset the buffer
-    memset(s_StrTempBuf, 0, BUF_SIZE);
-
-    // make a string with input log-message
-    vsnprintf(s_StrTempBuf, BUF_SIZE-1, format, args);
-
-    // print a message into the console and log file
-    SetConsoleColor(GREEN);
-    PrintHelper(fileName, funcName, "", s_StrTempBuf, codeLine);
-    SetConsoleColor(RESET);
-
+    Log(LOG_RECORD_MSG, fileName, funcName, codeLine, format, &args);
     va_end(args);
 }
 
@@ -176,7 +934,7 @@ void LogMsg(
 //         - format:     format string for variadic arguments
 //         - ...:        variadic arguments
 //---------------------------------------------------------
-void LogDbg(
+void LogDbgImpl(
     const char* fileName,
     const char* funcName,
     const int codeLine,
@@ -185,17 +943,7 @@ void LogDbg(
 {
     va_list args;
     va_start(args, format);
-
-    // reset the buffer
-    memset(s_StrTempBuf, 0, BUF_SIZE);
-
-    // make a string with input log-message
-    vsnprintf(s_StrTempBuf, BUF_SIZE-1, format, args);
-
-    // print a message into the console and log file
-    SetConsoleColor(RESET);
-    PrintHelper(fileName, funcName, "DEBUG:", s_StrTempBuf, codeLine);
-
+    Log(LOG_RECORD_DBG, fileName, funcName, codeLine, format, &args);
     va_end(args);
 }
 
@@ -207,7 +955,7 @@ void LogDbg(
 //         - format:     format string for variadic arguments
 //         - ...:        variadic arguments
 //---------------------------------------------------------
-void LogErr(
+void LogErrImpl(
     const char* fileName,
     const char* funcName,
     const int codeLine,
@@ -216,18 +964,6 @@ void LogErr(
 {
     va_list args;
     va_start(args, format);
-
-    // reset the buffer
-    memset(s_StrTempBuf, 0, BUF_SIZE);
-
-    // make a string with input log-message
-    vsnprintf(s_StrTempBuf, BUF_SIZE-1, format, args);
-
-    // print a message into the console and log file
-    SetConsoleColor(RED);
-    PrintHelper(fileName, funcName, "ERROR:", s_StrTempBuf, codeLine);
-    SetConsoleColor(RESET);
-
+    Log(LOG_RECORD_ERR, fileName, funcName, codeLine, format, &args);
     va_end(args);
 }
-
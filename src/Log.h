@@ -7,6 +7,9 @@
 #ifndef LOG_H
 #define LOG_H
 
+#include <stdint.h>
+#include <atomic>
+
 // defines to set console color
 #define RESET       "\033[0m"
 #define BLACK       "\033[30m"              /* Black */
@@ -29,35 +32,116 @@
 // define for standard log message (info about caller: file_name, func_name, code_line, message)
 #define LOG __FILE__, __func__, __LINE__
 
+// log levels (defines since they are compared by the preprocessor)
+#define LOG_LEVEL_DEBUG     0
+#define LOG_LEVEL_MSG       1
+#define LOG_LEVEL_ERR       2
+#define LOG_LEVEL_NONE      3
+
+// messages below this level are removed at compile time: their arguments
+// aren't even evaluated (build with -DLOG_COMPILE_LEVEL=LOG_LEVEL_MSG to remove debug messages)
+#ifndef LOG_COMPILE_LEVEL
+#define LOG_COMPILE_LEVEL   LOG_LEVEL_DEBUG
+#endif
+
+constexpr int LOG_RATE_MAX_MSGS  = 10;      // max messages of one call site per period
+constexpr int LOG_RATE_PERIOD_MS = 1000;
+
 // global string container
 extern char g_String[512];
 
+// ==================================================================
+// a place in code where a message is logged (is created once
+// on the first call); it holds:
+//  - category: a name of the source file (without path and extension)
+//    so levels can be set for each subsystem at runtime
+//  - a state of rate limiting: the messages over the limit are counted
+//    and reported as "message repeated N times"
+// ==================================================================
+struct LogSite
+{
+    LogSite(const char* fileName, const char* funcName, const int codeLine, const int level);
+
+    const char*           fileName = nullptr;
+    const char*           funcName = nullptr;
+    int                   codeLine = 0;
+    int                   level    = LOG_LEVEL_MSG;
+    int                   category = -1;
+
+    std::atomic<int64_t>  periodStartMs{0};
+    std::atomic<uint32_t> numInPeriod{0};
+    std::atomic<uint32_t> numSuppressed{0};
+
+    LogSite*              pNext = nullptr;    // a list of all the sites
+};
+
 // functions
 int InitLogger(void);
 void CloseLogger(void);
 void SetConsoleColor(const char* keyColor);
 
-void LogMsg(const char* format, ...);
+void SetLogLevel(const int level);
+void SetLogCategoryLevel(const char* category, const int level);
+bool SetLogLevels(const char* levels);
+bool SetLogBinaryFile(const char* filename);
+bool LogSiteFilter(LogSite& site);
 
-void LogMsg(
+void LogMsgImpl(const char* format, ...);
+
+void LogMsgImpl(
     const char* fileName,
     const char* funcName,
     const int codeLine,
     const char* format,
     ...);
 
-void LogDbg(
+void LogDbgImpl(
     const char* fileName,
     const char* funcName,
     const int codeLine,
     const char* format,
     ...);
 
-void LogErr(
+void LogErrImpl(
     const char* fileName,
     const char* funcName,
     const int codeLine,
     const char* format,
     ...);
 
+// ==================================================================
+// log macros: LogMsg("text"), LogMsg(LOG, "fmt", ...), LogDbg(LOG, ...), LogErr(LOG, ...)
+// ==================================================================
+#define LOG_SITE_CALL(level, func, ...)                                     \
+    do {                                                                    \
+        static LogSite s_LogSite(__FILE__, __func__, __LINE__, level);      \
+        if (LogSiteFilter(s_LogSite))                                       \
+            func(__VA_ARGS__);                                              \
+    } while (0)
+
+// a disabled message is still compiled (so it doesn't rot) but never called
+#define LOG_SITE_DISABLED(func, ...)                                        \
+    do {                                                                    \
+        if (0)                                                              \
+            func(__VA_ARGS__);                                              \
+    } while (0)
+
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_DEBUG
+#define LogDbg(...) LOG_SITE_CALL(LOG_LEVEL_DEBUG, LogDbgImpl, __VA_ARGS__)
+#else
+#define LogDbg(...) LOG_SITE_DISABLED(LogDbgImpl, __VA_ARGS__)
+#endif
+
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_MSG
+#define LogMsg(...) LOG_SITE_CALL(LOG_LEVEL_MSG, LogMsgImpl, __VA_ARGS__)
+#else
+#define LogMsg(...) LOG_SITE_DISABLED(LogMsgImpl, __VA_ARGS__)
+#endif
+
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_ERR
+#define LogErr(...) LOG_SITE_CALL(LOG_LEVEL_ERR, LogErrImpl, __VA_ARGS__)
+#else
+#define LogErr(...) LOG_SITE_DISABLED(LogErrImpl, __VA_ARGS__)
+#endif
+
 #endif
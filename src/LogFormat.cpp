@@ -0,0 +1,253 @@
+// ==================================================================
+// Filename:    LogFormat.cpp
+// Created:     19.10.2026 by DimaSkup
+// ==================================================================
+#include "LogFormat.h"
+#include <stddef.h>
+#include <stdio.h>
+
+// a parsed conversion specification of printf format: %[flags][width][.precision][length]conv
+struct FormatSpec
+{
+    const char* begin       = nullptr;     // '%'
+    const char* end         = nullptr;     // after the conversion char
+    char        conv        = 0;
+    char        length[3]   = {0};
+    bool        starWidth   = false;
+    bool        starPrec    = false;
+};
+
+//---------------------------------------------------------
+// Desc:   parse one conversion spec which starts at '%'
+//---------------------------------------------------------
+static const char* ParseSpec(const char* p, FormatSpec& spec)
+{
+    spec       = FormatSpec();
+    spec.begin = p++;
+
+    while (*p && strchr("-+ #0", *p))
+        p++;
+
+    if (*p == '*')
+    {
+        spec.starWidth = true;
+        p++;
+    }
+    while (*p >= '0' && *p <= '9')
+        p++;
+
+    if (*p == '.')
+    {
+        p++;
+        if (*p == '*')
+        {
+            spec.starPrec = true;
+            p++;
+        }
+        while (*p >= '0' && *p <= '9')
+            p++;
+    }
+
+    int n = 0;
+    while (*p && strchr("hljztL", *p) && n < 2)
+        spec.length[n++] = *p++;
+
+    spec.conv = *p;
+    spec.end  = (*p) ? p + 1 : p;
+    return spec.end;
+}
+
+//---------------------------------------------------------
+// Desc:   copy arguments by the format into the record buffer
+// Ret:    false if the buffer is too small
+//---------------------------------------------------------
+bool LogCaptureArgs(const char* format, va_list args, LogArgWriter& w)
+{
+    for (const char* p = format; *p; )
+    {
+        if (*p != '%')
+        {
+            p++;
+            continue;
+        }
+
+        if (p[1] == '%')
+        {
+            p += 2;
+            continue;
+        }
+
+        FormatSpec spec;
+        p = ParseSpec(p, spec);
+
+        if (spec.starWidth && !w.Write(va_arg(args, int))) return false;
+        if (spec.starPrec  && !w.Write(va_arg(args, int))) return false;
+
+        const char l0 = spec.length[0];
+        const char l1 = spec.length[1];
+        bool ok = true;
+
+        switch (spec.conv)
+        {
+            case 'd': case 'i': case 'c':
+            {
+                // all the integers are stored as 64-bit (signed ones are sign-extended)
+                int64_t value = 0;
+
+                if      (l0 == 'l' && l1 == 'l') value = (int64_t)va_arg(args, long long);
+                else if (l0 == 'l')              value = (int64_t)va_arg(args, long);
+                else if (l0 == 'z')              value = (int64_t)va_arg(args, size_t);
+                else if (l0 == 'j')              value = (int64_t)va_arg(args, intmax_t);
+                else if (l0 == 't')              value = (int64_t)va_arg(args, ptrdiff_t);
+                else if (l0 == 'h' && l1 == 'h') value = (int64_t)(signed char)va_arg(args, int);
+                else if (l0 == 'h')              value = (int64_t)(short)va_arg(args, int);
+                else                             value = (int64_t)va_arg(args, int);
+
+                ok = w.Write(value);
+                break;
+            }
+            case 'u': case 'o': case 'x': case 'X':
+            {
+                // unsigned ones are zero-extended (so 2^31 and above aren't printed as huge numbers)
+                uint64_t value = 0;
+
+                if      (l0 == 'l' && l1 == 'l') value = (uint64_t)va_arg(args, unsigned long long);
+                else if (l0 == 'l')              value = (uint64_t)va_arg(args, unsigned long);
+                else if (l0 == 'z')              value = (uint64_t)va_arg(args, size_t);
+                else if (l0 == 'j')              value = (uint64_t)va_arg(args, uintmax_t);
+                else if (l0 == 't')              value = (uint64_t)(size_t)va_arg(args, ptrdiff_t);
+                else if (l0 == 'h' && l1 == 'h') value = (uint64_t)(unsigned char)va_arg(args, int);
+                else if (l0 == 'h')              value = (uint64_t)(unsigned short)va_arg(args, int);
+                else                             value = (uint64_t)va_arg(args, unsigned int);
+
+                ok = w.Write((int64_t)value);
+                break;
+            }
+            case 'f': case 'F': case 'e': case 'E':
+            case 'g': case 'G': case 'a': case 'A':
+            {
+                const double value = (l0 == 'L') ? (double)va_arg(args, long double) : va_arg(args, double);
+                ok = w.Write(value);
+                break;
+            }
+            case 's':
+                ok = w.WriteStr(va_arg(args, const char*));
+                break;
+
+            case 'p':
+            case 'n':
+                ok = w.Write(va_arg(args, void*));
+                break;
+
+            default:
+                break;
+        }
+
+        if (!ok)
+            return false;
+    }
+
+    return true;
+}
+
+//---------------------------------------------------------
+// Desc:   format a message from the format and captured arguments;
+//         each conversion spec is formatted separately with its argument
+//---------------------------------------------------------
+void LogFormatArgs(const char* format, LogArgReader& r, char* outText, const int outSize)
+{
+    int  pos = 0;
+    char specBuf[32];
+    char strArg[LOG_MAX_STR_ARG + 1];
+
+    auto append = [&](const int n)
+    {
+        if (n > 0)
+            pos = (pos + n < outSize) ? pos + n : outSize - 1;
+    };
+
+    for (const char* p = format; *p && pos < outSize-1; )
+    {
+        if (*p != '%')
+        {
+            outText[pos++] = *p++;
+            continue;
+        }
+
+        if (p[1] == '%')
+        {
+            outText[pos++] = '%';
+            p += 2;
+            continue;
+        }
+
+        FormatSpec spec;
+        p = ParseSpec(p, spec);
+
+        // a copy of the spec without the length modifier (all the values are widened)
+        int len = 0;
+        for (const char* s = spec.begin; s < spec.end - 1 && len < (int)sizeof(specBuf) - 4; ++s)
+        {
+            if (!strchr("hljztL", *s))
+                specBuf[len++] = *s;
+        }
+
+        const bool isInt = (spec.conv && strchr("diouxXc", spec.conv));
+
+        if (isInt && spec.conv != 'c')
+        {
+            specBuf[len++] = 'l';
+            specBuf[len++] = 'l';
+        }
+        specBuf[len++] = spec.conv;
+        specBuf[len]   = '\0';
+
+        const int width = spec.starWidth ? r.Read<int>() : 0;
+        const int prec  = spec.starPrec  ? r.Read<int>() : 0;
+        char*     pOut  = outText + pos;
+        const int left  = outSize - pos;
+        int       n     = 0;
+
+        // the star values (if any) are passed before the argument
+        #define LOG_FORMAT_ARG(value)                                                         \
+            if      (spec.starWidth && spec.starPrec) n = snprintf(pOut, left, specBuf, width, prec, value); \
+            else if (spec.starWidth)                  n = snprintf(pOut, left, specBuf, width, value);       \
+            else if (spec.starPrec)                   n = snprintf(pOut, left, specBuf, prec, value);        \
+            else                                      n = snprintf(pOut, left, specBuf, value);
+
+        if (isInt && spec.conv == 'c')
+        {
+            LOG_FORMAT_ARG((int)r.Read<int64_t>());
+        }
+        else if (isInt && strchr("uoxX", spec.conv))
+        {
+            LOG_FORMAT_ARG((unsigned long long)r.Read<int64_t>());
+        }
+        else if (isInt)
+        {
+            LOG_FORMAT_ARG((long long)r.Read<int64_t>());
+        }
+        else if (spec.conv && strchr("fFeEgGaA", spec.conv))
+        {
+            LOG_FORMAT_ARG(r.Read<double>());
+        }
+        else if (spec.conv == 's')
+        {
+            LOG_FORMAT_ARG(r.ReadStr(strArg));
+        }
+        else if (spec.conv == 'p')
+        {
+            LOG_FORMAT_ARG(r.Read<void*>());
+        }
+        else if (spec.conv == 'n')
+        {
+            r.Read<void*>();
+        }
+
+        #undef LOG_FORMAT_ARG
+
+        append(n);
+    }
+
+    outText[pos] = '\0';
+}
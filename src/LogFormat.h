@@ -0,0 +1,120 @@
+// ==================================================================
+// Filename:    LogFormat.h
+// Description: encoding of log messages which is shared by the logger
+//              and the log decoder tool:
+//              - arguments of a message are captured by its format string
+//                as raw bytes (integers as 64-bit, floats as double,
+//                strings are copied) and formatted later
+//              - the binary log file: a header, then entries of two kinds:
+//                a site (file, func, line, format) is written once when
+//                it is met for the first time; a message holds only
+//                the site ID, a timestamp and the captured arguments
+//
+//              the binary log file layout (little-endian):
+//                header:  magic[8] "DUDELOG1", u32 clocks per second
+//                site:    u8 LOG_BIN_SITE, u32 id, u8 type, i32 line,
+//                         str file, str func, str format
+//                message: u8 LOG_BIN_MSG, u32 site id, i64 clock,
+//                         u16 size of args, args
+//                (str: u16 length + chars without null)
+//
+// Created:     19.10.2026 by DimaSkup
+// ==================================================================
+#ifndef LOG_FORMAT_H
+#define LOG_FORMAT_H
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <string.h>
+
+constexpr int  LOG_MAX_STR_ARG = 256;          // string args are truncated to this length
+
+constexpr char LOG_BIN_MAGIC[8] = { 'D', 'U', 'D', 'E', 'L', 'O', 'G', '1' };
+constexpr int  LOG_BIN_SITE     = 1;           // tags of entries in the binary log
+constexpr int  LOG_BIN_MSG      = 2;
+
+// types of log messages (are stored in the binary log)
+enum eLogRecordType : uint32_t
+{
+    LOG_RECORD_PLAIN,           // a message without info about the caller
+    LOG_RECORD_MSG,
+    LOG_RECORD_DBG,
+    LOG_RECORD_ERR,
+    LOG_RECORD_COLOR,           // switch the console color
+};
+
+//---------------------------------------------------------
+// Desc:   a helper to write values into the record buffer
+//---------------------------------------------------------
+struct LogArgWriter
+{
+    char* pBuf = nullptr;
+    int   pos  = 0;
+    int   size = 0;
+
+    template <typename T>
+    inline bool Write(const T& value)
+    {
+        if (pos + (int)sizeof(T) > size)
+            return false;
+
+        memcpy(pBuf + pos, &value, sizeof(T));
+        pos += sizeof(T);
+        return true;
+    }
+
+    inline bool WriteStr(const char* str)
+    {
+        if (!str)
+            str = "(null)";
+
+        const uint16_t len = (uint16_t)strnlen(str, LOG_MAX_STR_ARG);
+
+        if (!Write(len) || pos + len > size)
+            return false;
+
+        memcpy(pBuf + pos, str, len);
+        pos += len;
+        return true;
+    }
+};
+
+//---------------------------------------------------------
+// Desc:   a helper to read values from the record buffer
+//---------------------------------------------------------
+struct LogArgReader
+{
+    const char* pBuf = nullptr;
+    int         pos  = 0;
+    int         size = 0;
+
+    template <typename T>
+    inline T Read()
+    {
+        T value{};
+
+        if (pos + (int)sizeof(T) <= size)
+        {
+            memcpy(&value, pBuf + pos, sizeof(T));
+            pos += sizeof(T);
+        }
+        return value;
+    }
+
+    // outStr must have space for LOG_MAX_STR_ARG chars and null
+    inline const char* ReadStr(char* outStr)
+    {
+        const uint16_t len = Read<uint16_t>();
+        const int      n   = (pos + len <= size && len <= LOG_MAX_STR_ARG) ? len : 0;
+
+        memcpy(outStr, pBuf + pos, n);
+        outStr[n] = '\0';
+        pos += n;
+        return outStr;
+    }
+};
+
+bool LogCaptureArgs(const char* format, va_list args, LogArgWriter& w);
+void LogFormatArgs (const char* format, LogArgReader& r, char* outText, const int outSize);
+
+#endif
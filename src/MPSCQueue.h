@@ -0,0 +1,115 @@
+// ==================================================================
+// Filename:    MPSCQueue.h
+// Description: a bounded lock-free queue for multiple producers and
+//              a single consumer (based on Dmitry Vyukov's bounded queue):
+//              - each cell has a sequence number which tells
+//                if the cell is ready to be written or read
+//              - producers reserve a cell by CAS on the write position
+//              - the consumer doesn't need any CAS at all
+//
+//              NOTE: the order of items which are pushed by different
+//                    threads at the same time isn't defined
+//
+// Created:     19.10.2026 by DimaSkup
+// ==================================================================
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include <atomic>
+#include <stdint.h>
+
+template <typename T, int CAPACITY>
+class MPSCQueue
+{
+    static_assert((CAPACITY & (CAPACITY-1)) == 0, "capacity must be a power of 2");
+
+public:
+    MPSCQueue()
+    {
+        for (uint32_t i = 0; i < CAPACITY; ++i)
+            m_Cells[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    //-----------------------------------------------------
+    // Desc:  push an item (can be called from any thread)
+    // Ret:   false if the queue is full
+    //-----------------------------------------------------
+    bool Push(const T& item)
+    {
+        uint32_t pos = m_WritePos.load(std::memory_order_relaxed);
+        Cell*    pCell = nullptr;
+
+        while (true)
+        {
+            pCell = &m_Cells[pos & (CAPACITY-1)];
+
+            const uint32_t seq  = pCell->seq.load(std::memory_order_acquire);
+            const int32_t  diff = (int32_t)(seq - pos);
+
+            // the cell is free: try to reserve it
+            if (diff == 0)
+            {
+                if (m_WritePos.compare_exchange_weak(pos, pos+1, std::memory_order_relaxed))
+                    break;
+            }
+            // the cell isn't read yet: the queue is full
+            else if (diff < 0)
+            {
+                return false;
+            }
+            // another producer reserved this cell: take the fresh position
+            else
+            {
+                pos = m_WritePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        pCell->item = item;
+        pCell->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    //-----------------------------------------------------
+    // Desc:  pop an item (only from the consumer's thread)
+    // Ret:   false if the queue is empty
+    //-----------------------------------------------------
+    bool Pop(T& outItem)
+    {
+        Cell&          cell = m_Cells[m_ReadPos & (CAPACITY-1)];
+        const uint32_t seq  = cell.seq.load(std::memory_order_acquire);
+
+        // the cell isn't written yet
+        if (seq != m_ReadPos + 1)
+            return false;
+
+        outItem = cell.item;
+
+        // the cell can be written again on the next lap
+        cell.seq.store(m_ReadPos + CAPACITY, std::memory_order_release);
+        m_ReadPos++;
+        return true;
+    }
+
+private:
+    struct Cell
+    {
+        std::atomic<uint32_t> seq{0};
+        T                     item;
+    };
+
+    static constexpr int CACHE_LINE_SIZE = 64;
+
+    Cell                  m_Cells[CAPACITY];
+
+    // producers and the consumer write different positions so keep them
+    // in separate cache lines; it's done by explicit padding but not by
+    // alignas(64) because queues are members of heap objects (event channels)
+    // and plain new doesn't guarantee over-alignment in C++14
+    char                  m_Pad0[CACHE_LINE_SIZE];
+    std::atomic<uint32_t> m_WritePos{0};
+    char                  m_Pad1[CACHE_LINE_SIZE];
+    uint32_t              m_ReadPos = 0;
+    char                  m_Pad2[CACHE_LINE_SIZE - sizeof(uint32_t)];
+};
+
+#endif
@@ -5,6 +5,11 @@
 #include "StrHelper.h"
 #include "Entity.h"
 #include "Components/TileComponent.h"
+#include "JobSystem.h"
+#include <math.h>
+
+// init a global ptr to the current tilemap
+Map* g_pMap = nullptr;
 
 
 Map::Map(
@@ -51,25 +56,22 @@ void Map::LoadMap(
     // b) 13 = tile at row 1, column 3
     // c) 09 = tile at row 0, column 9
     char ch = 0;
-    int srcRectX = 0;
-    int srcRectY = 0;
-    const int tileSize = m_TileSize;
-    const int scaleFactor = m_Scale * tileSize;
+    int tileCode = 0;
+
+    InitGrid(mapSizeX, mapSizeY);
 
     for (int y = 0; y < mapSizeY; ++y)
     {
         for (int x = 0; x < mapSizeX; ++x)
         {
-            // read in the tile row and compute tile's posY on the tile texture
+            // read in the tile row and column
             ch = fgetc(pFile);
-            srcRectY = atoi(&ch) * tileSize;
+            tileCode = (ch - '0') * 10;
 
-            // read in the tile column and compute tile's posX on the tile texture
             ch = fgetc(pFile);
-            srcRectX = atoi(&ch) * tileSize;
+            tileCode += (ch - '0');
 
-            // create and setup new tile entity
-            AddTile(srcRectX, srcRectY, x * scaleFactor, y * scaleFactor);
+            SetTile(x, y, tileCode);
 
             // ignore ","
             ch = fgetc(pFile);
@@ -79,6 +81,103 @@ void Map::LoadMap(
     fclose(pFile);
 }
 
+//---------------------------------------------------------
+// Desc:   a random number of the map cell (a hash of the seed and cell index
+//         so cells can be generated in any order)
+//---------------------------------------------------------
+static inline uint32_t HashCell(const uint32_t seed, const uint32_t cellIdx)
+{
+    uint32_t x = seed ^ (cellIdx * 0x9E3779B9u);
+
+    x ^= x >> 16;
+    x *= 0x7FEB352Du;
+    x ^= x >> 15;
+    x *= 0x846CA68Bu;
+    x ^= x >> 16;
+
+    return x;
+}
+
+//---------------------------------------------------------
+// Desc:   fill the map with random tiles instead of reading a .map file
+//         (for stress scenes of any size); tile codes are generated
+//         in parallel, then tiles are created on this thread
+// Args:   - mapSizeX, mapSizeY:  size of the map in tiles
+//         - seed:                the same seed gives the same map
+//---------------------------------------------------------
+void Map::GenerateMap(
+    const int mapSizeX,
+    const int mapSizeY,
+    const uint32_t seed)
+{
+    // tile codes of the tileset: 3 rows x 10 columns
+    constexpr int numTileRows = 3;
+    constexpr int numTileCols = 10;
+
+    const int numCells = mapSizeX * mapSizeY;
+    std::vector<uint8_t> tileCodes(numCells);
+
+    g_JobSystem.ParallelFor(numCells, MAP_GEN_CHUNK_SIZE,
+        [&tileCodes, seed](const int chunkIdx, const int begin, const int end)
+        {
+            for (int i = begin; i < end; ++i)
+            {
+                const uint32_t h   = HashCell(seed, (uint32_t)i);
+                const int      row = (h >> 8)  % numTileRows;
+                const int      col = (h >> 16) % numTileCols;
+
+                tileCodes[i] = (uint8_t)(row * 10 + col);
+            }
+        });
+
+    InitGrid(mapSizeX, mapSizeY);
+
+    for (int y = 0; y < mapSizeY; ++y)
+    {
+        for (int x = 0; x < mapSizeX; ++x)
+            SetTile(x, y, tileCodes[y * mapSizeX + x]);
+    }
+}
+
+//---------------------------------------------------------
+// Desc:   setup the terrain flags grid: a bit plane per each tile flag
+//---------------------------------------------------------
+void Map::InitGrid(const int mapSizeX, const int mapSizeY)
+{
+    m_MapSizeX = mapSizeX;
+    m_MapSizeY = mapSizeY;
+    m_CellSize = m_Scale * m_TileSize;
+
+    const int numWords = (mapSizeX * mapSizeY + 31) / 32;
+
+    for (int i = 0; i < NUM_TILE_FLAGS; ++i)
+        m_FlagBits[i].assign(numWords, 0);
+}
+
+//---------------------------------------------------------
+// Desc:   create a tile entity at the cell and store its terrain flags
+// Args:   - x, y:      the cell of the map
+//         - tileCode:  [row][column] of the tile on the tileset texture
+//---------------------------------------------------------
+void Map::SetTile(const int x, const int y, const int tileCode)
+{
+    const int srcRectY = (tileCode / 10) * m_TileSize;
+    const int srcRectX = (tileCode % 10) * m_TileSize;
+
+    // create and setup new tile entity
+    AddTile(srcRectX, srcRectY, x * m_CellSize, y * m_CellSize);
+
+    // store terrain flags of this tile into the bit planes
+    if (0 <= tileCode && tileCode < MAX_NUM_TILE_CODES)
+    {
+        const int     cellIdx = y * m_MapSizeX + x;
+        const uint8_t flags   = m_FlagsByTileCode[tileCode];
+
+        for (int i = 0; i < NUM_TILE_FLAGS; ++i)
+            m_FlagBits[i][cellIdx >> 5] |= (uint32_t)((flags >> i) & 1) << (cellIdx & 31);
+    }
+}
+
 ///////////////////////////////////////////////////////////
 
 void Map::AddTile(
@@ -96,3 +195,186 @@ void Map::AddTile(
         m_Scale, 
         m_TextureID.c_str());
 }
+
+//---------------------------------------------------------
+// Desc:   convert a string with tile flags names into bit flags
+// Args:   - str: for instance: "solid", "water,slow", etc.
+// Ret:    a combination of eTileFlag bits
+//---------------------------------------------------------
+uint8_t Map::ParseTileFlags(const char* str)
+{
+    if (IsStrEmpty(str))
+        return TILE_FLAG_NONE;
+
+    uint8_t flags = TILE_FLAG_NONE;
+
+    if (strstr(str, "solid")) flags |= TILE_FLAG_SOLID;
+    if (strstr(str, "water")) flags |= TILE_FLAG_WATER;
+    if (strstr(str, "slow"))  flags |= TILE_FLAG_SLOW;
+
+    return flags;
+}
+
+//---------------------------------------------------------
+// Desc:   setup terrain flags for a tile of the tileset;
+//         must be called before LoadMap()
+// Args:   - tileCode: 2 digits code of tile as in .map file (row, column)
+//         - flags:    a combination of eTileFlag bits
+//---------------------------------------------------------
+void Map::SetTileFlags(const int tileCode, const uint8_t flags)
+{
+    if (tileCode < 0 || tileCode >= MAX_NUM_TILE_CODES)
+    {
+        LogErr(LOG, "invalid tile code: %d", tileCode);
+        return;
+    }
+
+    m_FlagsByTileCode[tileCode] = flags;
+}
+
+//---------------------------------------------------------
+// Desc:   get a union of terrain flags of all the tiles which
+//         are touched by the input rect
+// Args:   - rect: a rectangle in world space
+//---------------------------------------------------------
+uint8_t Map::GetFlagsInRect(const SDL_Rect& rect) const
+{
+    if (m_CellSize <= 0 || m_FlagBits[0].empty())
+        return TILE_FLAG_NONE;
+
+    const int minCellX = (int)floorf((float)rect.x / m_CellSize);
+    const int minCellY = (int)floorf((float)rect.y / m_CellSize);
+    const int maxCellX = (int)floorf((float)(rect.x + rect.w - 1) / m_CellSize);
+    const int maxCellY = (int)floorf((float)(rect.y + rect.h - 1) / m_CellSize);
+
+    uint8_t flags = TILE_FLAG_NONE;
+
+    for (int i = 0; i < NUM_TILE_FLAGS; ++i)
+    {
+        if (IsBlocked(minCellX, minCellY, maxCellX, maxCellY, 1 << i))
+            flags |= (1 << i);
+    }
+
+    return flags;
+}
+
+//---------------------------------------------------------
+// Desc:   resolve movement of AABB from the prev position to the new one
+//         against the tiles with blocking flags (separately by X and Y,
+//         so we can slide along walls); only cells which are crossed
+//         during this move are tested
+// Args:   - prevPos:       AABB's position before the move
+//         - width, height: AABB's size in pixels
+//         - blockMask:     tile flags which block this AABB
+// InOut:  - inOutPos:      the desired position -> the resolved position
+//---------------------------------------------------------
+void Map::ResolveMove(
+    const glm::vec2& prevPos,
+    const int width,
+    const int height,
+    const uint8_t blockMask,
+    glm::vec2& inOutPos) const
+{
+    if (!blockMask || m_CellSize <= 0 || m_FlagBits[0].empty())
+        return;
+
+    const int   cs = m_CellSize;
+    const float w  = (float)width;
+    const float h  = (float)height;
+
+    // --- move by X (rows are taken from the prev position) ---
+    const int minRow = (int)floorf(prevPos.y / cs);
+    const int maxRow = (int)floorf((prevPos.y + h - 1) / cs);
+
+    if (inOutPos.x > prevPos.x)
+    {
+        const int fromCol = (int)floorf((prevPos.x + w - 1) / cs) + 1;
+        const int toCol   = (int)floorf((inOutPos.x + w - 1) / cs);
+
+        for (int col = fromCol; col <= toCol; ++col)
+        {
+            if (IsBlocked(col, minRow, col, maxRow, blockMask))
+            {
+                inOutPos.x = (float)(col * cs) - w;
+                break;
+            }
+        }
+    }
+    else if (inOutPos.x < prevPos.x)
+    {
+        const int fromCol = (int)floorf(prevPos.x / cs) - 1;
+        const int toCol   = (int)floorf(inOutPos.x / cs);
+
+        for (int col = fromCol; col >= toCol; --col)
+        {
+            if (IsBlocked(col, minRow, col, maxRow, blockMask))
+            {
+                inOutPos.x = (float)((col + 1) * cs);
+                break;
+            }
+        }
+    }
+
+    // --- move by Y (columns are taken from the resolved X) ---
+    const int minCol = (int)floorf(inOutPos.x / cs);
+    const int maxCol = (int)floorf((inOutPos.x + w - 1) / cs);
+
+    if (inOutPos.y > prevPos.y)
+    {
+        const int fromRow = (int)floorf((prevPos.y + h - 1) / cs) + 1;
+        const int toRow   = (int)floorf((inOutPos.y + h - 1) / cs);
+
+        for (int row = fromRow; row <= toRow; ++row)
+        {
+            if (IsBlocked(minCol, row, maxCol, row, blockMask))
+            {
+                inOutPos.y = (float)(row * cs) - h;
+                break;
+            }
+        }
+    }
+    else if (inOutPos.y < prevPos.y)
+    {
+        const int fromRow = (int)floorf(prevPos.y / cs) - 1;
+        const int toRow   = (int)floorf(inOutPos.y / cs);
+
+        for (int row = fromRow; row >= toRow; --row)
+        {
+            if (IsBlocked(minCol, row, maxCol, row, blockMask))
+            {
+                inOutPos.y = (float)((row + 1) * cs);
+                break;
+            }
+        }
+    }
+}
+
+//---------------------------------------------------------
+// Desc:   check if any cell in the input range has any of blocking flags;
+//         cells outside the map are never blocked
+//---------------------------------------------------------
+bool Map::IsBlocked(
+    const int minCellX,
+    const int minCellY,
+    const int maxCellX,
+    const int maxCellY,
+    const uint8_t blockMask) const
+{
+    const int x0 = (minCellX < 0) ? 0 : minCellX;
+    const int y0 = (minCellY < 0) ? 0 : minCellY;
+    const int x1 = (maxCellX >= m_MapSizeX) ? m_MapSizeX-1 : maxCellX;
+    const int y1 = (maxCellY >= m_MapSizeY) ? m_MapSizeY-1 : maxCellY;
+
+    for (int i = 0; i < NUM_TILE_FLAGS; ++i)
+    {
+        if (!(blockMask & (1 << i)))
+            continue;
+
+        for (int y = y0; y <= y1; ++y)
+            for (int x = x0; x <= x1; ++x)
+                if (HasFlagBit(i, y * m_MapSizeX + x))
+                    return true;
+    }
+
+    return false;
+}
@@ -1,7 +1,27 @@
 #ifndef MAP_H
 #define MAP_H
 
+#include "../lib/glm/glm.hpp"
+#include <SDL2/SDL.h>
+#include <stdint.h>
 #include <string>
+#include <vector>
+
+// terrain flags of a tile (defined per tile of the tileset)
+enum eTileFlag
+{
+    TILE_FLAG_NONE  = 0,
+    TILE_FLAG_SOLID = 1 << 0,       // nothing can pass through
+    TILE_FLAG_WATER = 1 << 1,       // ground units can't pass through
+    TILE_FLAG_SLOW  = 1 << 2,       // movement is slowed down
+};
+
+constexpr int NUM_TILE_FLAGS     = 3;
+constexpr int MAX_NUM_TILE_CODES = 100;   // tile codes in .map file are 2 digits: [row][column]
+constexpr float TILE_SLOW_FACTOR = 0.5f;  // velocity multiplier on the TILE_FLAG_SLOW tiles
+constexpr int MAP_GEN_CHUNK_SIZE = 4096;  // cells per job when a map is generated
+
+//===================================================================
 
 class Map
 {
@@ -10,20 +30,64 @@ public:
     ~Map() {};
 
     void LoadMap(
-        const char* filePath, 
-        const int mapSizeX, 
+        const char* filePath,
+        const int mapSizeX,
         const int mapSizeY);
 
+    void GenerateMap(
+        const int mapSizeX,
+        const int mapSizeY,
+        const uint32_t seed);
+
     void AddTile(
-        const int srcRectX, 
-        const int srcRectY, 
-        const int x, 
+        const int srcRectX,
+        const int srcRectY,
+        const int x,
         const int y);
 
+    static uint8_t ParseTileFlags(const char* str);
+    void           SetTileFlags(const int tileCode, const uint8_t flags);
+
+    uint8_t GetFlagsInRect(const SDL_Rect& rect) const;
+
+    void ResolveMove(
+        const glm::vec2& prevPos,
+        const int width,
+        const int height,
+        const uint8_t blockMask,
+        glm::vec2& inOutPos) const;
+
+private:
+    void InitGrid(const int mapSizeX, const int mapSizeY);
+    void SetTile(const int x, const int y, const int tileCode);
+
+    bool IsBlocked(
+        const int minCellX,
+        const int minCellY,
+        const int maxCellX,
+        const int maxCellY,
+        const uint8_t blockMask) const;
+
+    inline bool HasFlagBit(const int flagIdx, const int cellIdx) const
+    {
+        return (m_FlagBits[flagIdx][cellIdx >> 5] >> (cellIdx & 31)) & 1;
+    }
+
 private:
     std::string m_TextureID;
     int m_Scale = 0;
     int m_TileSize = 0;
+    int m_MapSizeX = 0;                                  // in tiles
+    int m_MapSizeY = 0;
+    int m_CellSize = 0;                                  // tile size in pixels (with scale)
+
+    uint8_t               m_FlagsByTileCode[MAX_NUM_TILE_CODES]{0};
+    std::vector<uint32_t> m_FlagBits[NUM_TILE_FLAGS];    // a bit plane per each tile flag
 };
 
+// ==================================================================
+// Declare a global ptr to the current tilemap
+// ==================================================================
+extern Map* g_pMap;
+
 #endif
@@ -0,0 +1,427 @@
+// ==================================================================
+// Filename:    Profiler.cpp
+// Created:     19.10.2026 by DimaSkup
+// ==================================================================
+#include "Profiler.h"
+#include "Render.h"
+#include "AssetMgr.h"
+#include "Log.h"
+#include "TraceRecorder.h"
+#include <SDL2/SDL_ttf.h>
+#include <string.h>
+#include <stdio.h>
+
+// init a global instance of the profiler
+Profiler g_Profiler;
+
+// how often the overlay text is updated
+constexpr uint32_t OVERLAY_UPDATE_PERIOD_MS = 250;
+
+// a tree of the current thread (only threads which call BeginFrame have it)
+static thread_local int t_TreeIdx = -1;
+
+
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// Desc:   add a tree of zones for the calling thread (if it doesn't have it yet);
+//         trees are merged in order of registration so the main thread
+//         should be registered before the others are started
+// Args:   - frameName:  a name of the root zone of the thread's frame
+//---------------------------------------------------------
+void Profiler::RegisterThread(const char* frameName)
+{
+    if (t_TreeIdx != -1)
+        return;
+
+    std::lock_guard<std::mutex> lock(m_RegisterMutex);
+
+    const int idx = m_NumTrees.load(std::memory_order_relaxed);
+
+    if (idx >= PROFILER_MAX_THREADS)
+    {
+        LogErr(LOG, "too many profiled threads, can't add: %s", frameName);
+        return;
+    }
+
+    ThreadTree& tree = m_Trees[idx];
+    tree.nodes[0].name = frameName;
+    tree.numNodes      = 1;
+    tree.msPerTick     = 1000.0 / (double)SDL_GetPerformanceFrequency();
+
+    // readers see the tree only when it's ready
+    m_NumTrees.store(idx + 1, std::memory_order_release);
+    t_TreeIdx = idx;
+}
+
+//---------------------------------------------------------
+// Desc:   is the calling thread measured by its own tree of zones
+//---------------------------------------------------------
+bool Profiler::IsThreadProfiled()
+{
+    return t_TreeIdx != -1;
+}
+
+//---------------------------------------------------------
+// Desc:   start measuring of a new frame of the calling thread
+// Args:   - frameName:  a name of the root zone (is used only when
+//                       the thread isn't registered yet)
+//---------------------------------------------------------
+void Profiler::BeginFrame(const char* frameName)
+{
+    RegisterThread(frameName);
+
+    if (t_TreeIdx == -1)
+        return;
+
+    ThreadTree& tree = m_Trees[t_TreeIdx];
+
+    tree.stackDepth = 0;
+    tree.currNode   = 0;
+    tree.frameStart = SDL_GetPerformanceCounter();
+}
+
+//---------------------------------------------------------
+// Desc:   store per-frame timings of all the zones of the calling
+//         thread into the window
+//---------------------------------------------------------
+void Profiler::EndFrame()
+{
+    if (t_TreeIdx == -1)
+        return;
+
+    ThreadTree& tree = m_Trees[t_TreeIdx];
+
+    if (tree.frameStart == 0)
+        return;
+
+    // close zones which weren't closed (shouldn't happen with scopes)
+    while (tree.stackDepth > 0)
+        EndZone();
+
+    const uint64_t frameEnd = SDL_GetPerformanceCounter();
+
+    tree.nodes[0].frameTicks = frameEnd - tree.frameStart;
+    tree.nodes[0].frameCalls = 1;
+    g_TraceRecorder.AddEvent(tree.nodes[0].name, tree.frameStart, frameEnd);
+
+    std::lock_guard<std::mutex> lock(tree.mutex);
+
+    for (int i = 0; i < tree.numNodes; ++i)
+    {
+        ZoneNode& node = tree.nodes[i];
+
+        node.historyMs[tree.historyIdx] = (float)(node.frameTicks * tree.msPerTick);
+        node.totalMs   += node.historyMs[tree.historyIdx];
+        node.lastCalls  = node.frameCalls;
+        node.frameTicks = 0;
+        node.frameCalls = 0;
+    }
+
+    tree.historyIdx = (tree.historyIdx + 1) % PROFILER_WINDOW_FRAMES;
+
+    if (tree.numFrames < PROFILER_WINDOW_FRAMES)
+        tree.numFrames++;
+}
+
+//---------------------------------------------------------
+// Desc:   open a zone as a child of the current one (of the calling thread)
+// Args:   - name:    a name of the zone (a string literal)
+//         - isWait:  the zone only waits for another thread
+//---------------------------------------------------------
+void Profiler::BeginZone(const char* name, const bool isWait)
+{
+    ThreadTree& tree = m_Trees[t_TreeIdx];
+
+    if (tree.stackDepth >= PROFILER_MAX_DEPTH)
+    {
+        // we still push it so the EndZone is paired
+        tree.stackDepth++;
+        return;
+    }
+
+    const int node = FindOrAddChild(tree, tree.currNode, name, isWait);
+
+    tree.stack[tree.stackDepth].node       = node;
+    tree.stack[tree.stackDepth].startTicks = SDL_GetPerformanceCounter();
+    tree.stackDepth++;
+
+    if (node != -1)
+        tree.currNode = node;
+}
+
+//---------------------------------------------------------
+// Desc:   close the current zone and add its time to the frame
+//---------------------------------------------------------
+void Profiler::EndZone()
+{
+    ThreadTree& tree = m_Trees[t_TreeIdx];
+
+    if (tree.stackDepth == 0)
+        return;
+
+    tree.stackDepth--;
+
+    if (tree.stackDepth >= PROFILER_MAX_DEPTH)
+        return;
+
+    const OpenZone& zone = tree.stack[tree.stackDepth];
+
+    if (zone.node == -1)
+        return;
+
+    ZoneNode& node = tree.nodes[zone.node];
+    node.frameTicks += SDL_GetPerformanceCounter() - zone.startTicks;
+    node.frameCalls++;
+
+    tree.currNode = node.parent;
+}
+
+//---------------------------------------------------------
+// Desc:   get stats of all the zones over the window: the trees of
+//         all the threads one after another (in order of the tree:
+//         a parent before its children)
+//---------------------------------------------------------
+void Profiler::GetStats(std::vector<ProfileZoneStats>& outStats) const
+{
+    outStats.clear();
+
+    const int numTrees = m_NumTrees.load(std::memory_order_acquire);
+
+    for (int i = 0; i < numTrees; ++i)
+    {
+        std::lock_guard<std::mutex> lock(m_Trees[i].mutex);
+        AddStats(m_Trees[i], 0, outStats);
+    }
+}
+
+//---------------------------------------------------------
+// Desc:   find the longest top-level zone of the last finished frame
+//         among all the threads (zones which only wait for another
+//         thread are skipped: that thread has the real reason)
+// Args:   - outMs:  its time in milliseconds
+// Ret:    a name of the zone or nullptr if there are no zones
+//---------------------------------------------------------
+const char* Profiler::GetSlowestPhase(float& outMs) const
+{
+    const char* name     = nullptr;
+    const int   numTrees = m_NumTrees.load(std::memory_order_acquire);
+
+    outMs = 0;
+
+    for (int t = 0; t < numTrees; ++t)
+    {
+        const ThreadTree& tree = m_Trees[t];
+        std::lock_guard<std::mutex> lock(tree.mutex);
+
+        const int lastIdx = (tree.historyIdx + PROFILER_WINDOW_FRAMES - 1) % PROFILER_WINDOW_FRAMES;
+
+        for (int i = tree.nodes[0].firstChild; i != -1; i = tree.nodes[i].nextSibling)
+        {
+            const ZoneNode& node = tree.nodes[i];
+
+            if (!node.isWait && node.historyMs[lastIdx] > outMs)
+            {
+                outMs = node.historyMs[lastIdx];
+                name  = node.name;
+            }
+        }
+    }
+
+    return name;
+}
+
+//---------------------------------------------------------
+// Desc:   draw stats of zones as a list of text lines
+// Args:   - fontID:      a font from the asset manager
+//         - posX, posY:  the top left corner of the overlay
+//---------------------------------------------------------
+void Profiler::RenderOverlay(const char* fontID, const int posX, const int posY)
+{
+    if (!m_ShowOverlay)
+        return;
+
+    const uint32_t now = SDL_GetTicks();
+
+    // recreate text textures only from time to time
+    if (m_OverlayLines.empty() || (now - m_LastOverlayMs >= OVERLAY_UPDATE_PERIOD_MS))
+    {
+        TTF_Font* pFont = g_AssetMgr.GetFont(fontID);
+
+        if (!pFont)
+            return;
+
+        ReleaseOverlay();
+        m_LastOverlayMs = now;
+
+        std::vector<ProfileZoneStats> stats;
+        GetStats(stats);
+
+        const SDL_Color color = { 255, 255, 0, 255 };
+        char line[128];
+
+        snprintf(line, sizeof(line), "%-28s %8s %8s %8s", "zone (ms)", "avg", "min", "max");
+        stats.insert(stats.begin(), ProfileZoneStats());
+
+        for (size_t i = 0; i < stats.size(); ++i)
+        {
+            const ProfileZoneStats& s = stats[i];
+
+            if (i > 0)
+            {
+                char name[64];
+                snprintf(name, sizeof(name), "%*s%s", s.depth * 2, "", s.name);
+                snprintf(line, sizeof(line), "%-28s %8.3f %8.3f %8.3f", name, s.avgMs, s.minMs, s.maxMs);
+            }
+
+            SDL_Surface* pSurface = TTF_RenderText_Blended(pFont, line, color);
+            SDL_Texture* pTexture = SDL_CreateTextureFromSurface(g_pRenderer, pSurface);
+            SDL_FreeSurface(pSurface);
+
+            SDL_Rect rect = { posX, 0, 0, 0 };
+            SDL_QueryTexture(pTexture, NULL, NULL, &rect.w, &rect.h);
+
+            m_OverlayLines.push_back(pTexture);
+            m_OverlayRects.push_back(rect);
+        }
+    }
+
+    // compute the size of background and place the lines one by one
+    int width  = 0;
+    int height = 0;
+
+    for (SDL_Rect& rect : m_OverlayRects)
+    {
+        rect.y = posY + height;
+        height += rect.h;
+        width   = (rect.w > width) ? rect.w : width;
+    }
+
+    SDL_SetRenderDrawBlendMode(g_pRenderer, SDL_BLENDMODE_BLEND);
+    Render::DrawRectFilled(posX - 4, posY - 4, width + 8, height + 8, 0, 0, 0, 180);
+    SDL_SetRenderDrawBlendMode(g_pRenderer, SDL_BLENDMODE_NONE);
+
+    for (size_t i = 0; i < m_OverlayLines.size(); ++i)
+        SDL_RenderCopy(g_pRenderer, m_OverlayLines[i], NULL, &m_OverlayRects[i]);
+}
+
+//---------------------------------------------------------
+// Desc:   find a child zone of the parent by name or add a new one
+// Args:   - isWait:  a new zone only waits for another thread
+// Ret:    index of the node or -1 if there are too many zones
+//---------------------------------------------------------
+int Profiler::FindOrAddChild(
+    ThreadTree& tree,
+    const int parent,
+    const char* name,
+    const bool isWait)
+{
+    ZoneNode* nodes     = tree.nodes;
+    int       prevChild = -1;
+
+    for (int i = nodes[parent].firstChild; i != -1; i = nodes[i].nextSibling)
+    {
+        // usually names are the same literals so we compare ptrs at first
+        if (nodes[i].name == name || strcmp(nodes[i].name, name) == 0)
+            return i;
+
+        prevChild = i;
+    }
+
+    if (tree.numNodes >= PROFILER_MAX_ZONES)
+    {
+        LogErr(LOG, "too many profiler zones, can't add: %s", name);
+        return -1;
+    }
+
+    // the tree can be read by another thread right now
+    std::lock_guard<std::mutex> lock(tree.mutex);
+
+    // add a new child at the end of list (so the order is as in the code)
+    const int idx = tree.numNodes++;
+    ZoneNode& node = nodes[idx];
+
+    node.name   = name;
+    node.parent = parent;
+    node.depth  = nodes[parent].depth + 1;
+    node.isWait = isWait;
+
+    if (prevChild == -1)
+        nodes[parent].firstChild = idx;
+    else
+        nodes[prevChild].nextSibling = idx;
+
+    return idx;
+}
+
+//---------------------------------------------------------
+// Desc:   compute min/avg/max of the node and add it with
+//         all its children into the output array
+//---------------------------------------------------------
+void Profiler::AddStats(
+    const ThreadTree& tree,
+    const int nodeIdx,
+    std::vector<ProfileZoneStats>& outStats) const
+{
+    const ZoneNode& node = tree.nodes[nodeIdx];
+
+    ProfileZoneStats s;
+    s.name  = node.name;
+    s.depth = node.depth;
+    s.calls = node.lastCalls;
+    s.totalMs = (float)node.totalMs;
+
+    if (tree.numFrames > 0)
+    {
+        float sum = 0;
+        s.minMs   = node.historyMs[0];
+        s.maxMs   = node.historyMs[0];
+
+        for (int i = 0; i < tree.numFrames; ++i)
+        {
+            const float ms = node.historyMs[i];
+            sum += ms;
+            s.minMs = (ms < s.minMs) ? ms : s.minMs;
+            s.maxMs = (ms > s.maxMs) ? ms : s.maxMs;
+        }
+
+        s.avgMs = sum / tree.numFrames;
+    }
+
+    outStats.push_back(s);
+
+    for (int i = node.firstChild; i != -1; i = tree.nodes[i].nextSibling)
+        AddStats(tree, i, outStats);
+}
+
+//---------------------------------------------------------
+// Desc:   release textures of the overlay (before the renderer is destroyed)
+//---------------------------------------------------------
+void Profiler::ReleaseOverlay()
+{
+    for (SDL_Texture* pTexture : m_OverlayLines)
+        SDL_DestroyTexture(pTexture);
+
+    m_OverlayLines.clear();
+    m_OverlayRects.clear();
+}
+
+//==================================================================
+// ProfileScope
+//==================================================================
+ProfileScope::ProfileScope(const char* name, const bool isWait) :
+    m_Name(name),
+    m_StartTicks(SDL_GetPerformanceCounter()),
+    m_IsProfiled(Profiler::IsThreadProfiled())
+{
+    if (m_IsProfiled)
+        g_Profiler.BeginZone(name, isWait);
+}
+
+ProfileScope::~ProfileScope()
+{
+    if (m_IsProfiled)
+        g_Profiler.EndZone();
+
+    g_TraceRecorder.AddEvent(m_Name, m_StartTicks, SDL_GetPerformanceCounter());
+}
@@ -0,0 +1,168 @@
+// ==================================================================
+// Filename:    Profiler.h
+// Description: a hierarchical CPU frame profiler:
+//              - code is marked by scoped zones: PROFILE_ZONE("name");
+//              - nested zones make a tree (a zone is identified by its
+//                name and its parent), timings are taken by
+//                SDL_GetPerformanceCounter and accumulated per frame
+//              - per-frame time of each zone is kept in a rolling window
+//                so we can show min/avg/max of the recent frames
+//              - the tree is drawn as an overlay on the screen
+//              - each zone is also added into the trace recorder
+//              - each thread which calls BeginFrame/EndFrame (the main and
+//                the simulation threads) has its own tree; stats and the
+//                overlay merge all the trees: one after another in order of
+//                registration; zones of other threads (for instance, job
+//                workers) only go into the trace recorder
+//
+// Created:     19.10.2026 by DimaSkup
+// ==================================================================
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <SDL2/SDL.h>
+#include <stdint.h>
+#include <vector>
+#include <mutex>
+#include <atomic>
+
+// set to 0 to remove all the zones from the code
+#define ENABLE_PROFILER 1
+
+constexpr int PROFILER_MAX_ZONES     = 64;
+constexpr int PROFILER_MAX_DEPTH     = 16;
+constexpr int PROFILER_WINDOW_FRAMES = 120;     // frames in the rolling window
+constexpr int PROFILER_MAX_THREADS   = 4;       // threads with their own tree of zones
+
+// stats of a zone over the rolling window (in milliseconds)
+struct ProfileZoneStats
+{
+    const char* name  = nullptr;
+    int         depth = 0;
+    float       minMs = 0;
+    float       avgMs = 0;
+    float       maxMs = 0;
+    float       totalMs = 0;        // over the whole run
+    uint32_t    calls = 0;          // calls during the last frame
+};
+
+class Profiler
+{
+public:
+    Profiler() {}
+
+    void RegisterThread(const char* frameName);
+
+    void BeginFrame(const char* frameName = "Frame");
+    void EndFrame();
+
+    void BeginZone(const char* name, const bool isWait);
+    void EndZone();
+
+    static bool IsThreadProfiled();
+
+    void GetStats(std::vector<ProfileZoneStats>& outStats) const;
+    const char* GetSlowestPhase(float& outMs) const;
+
+    void RenderOverlay(const char* fontID, const int posX, const int posY);
+    void ReleaseOverlay();
+    inline void ToggleOverlay() { m_ShowOverlay = !m_ShowOverlay; }
+
+private:
+    struct ZoneNode
+    {
+        const char* name        = nullptr;
+        int         parent      = -1;
+        int         firstChild  = -1;
+        int         nextSibling = -1;
+        int         depth       = 0;
+        bool        isWait      = false;     // the thread waits for another one (see PROFILE_WAIT_ZONE)
+        uint64_t    frameTicks  = 0;         // accumulated during the current frame
+        uint32_t    frameCalls  = 0;
+        uint32_t    lastCalls   = 0;
+        double      totalMs     = 0;         // accumulated over the whole run
+        float       historyMs[PROFILER_WINDOW_FRAMES]{0};
+    };
+
+    struct OpenZone
+    {
+        int      node       = -1;
+        uint64_t startTicks = 0;
+    };
+
+    // zones of one thread: is modified only by its thread, the mutex guards
+    // the data which is read by other threads (new nodes and the history)
+    struct ThreadTree
+    {
+        ZoneNode   nodes[PROFILER_MAX_ZONES];
+        int        numNodes   = 0;
+        OpenZone   stack[PROFILER_MAX_DEPTH];
+        int        stackDepth = 0;
+        int        currNode   = 0;          // the root node is the whole frame
+
+        uint64_t   frameStart = 0;
+        double     msPerTick  = 0;
+        int        historyIdx = 0;
+        int        numFrames  = 0;          // frames in the window (<= PROFILER_WINDOW_FRAMES)
+
+        mutable std::mutex mutex;
+    };
+
+    int FindOrAddChild(
+        ThreadTree& tree,
+        const int parent,
+        const char* name,
+        const bool isWait);
+
+    void AddStats(
+        const ThreadTree& tree,
+        const int nodeIdx,
+        std::vector<ProfileZoneStats>& outStats) const;
+
+private:
+    ThreadTree       m_Trees[PROFILER_MAX_THREADS];
+    std::atomic<int> m_NumTrees{0};
+    std::mutex       m_RegisterMutex;
+
+    // overlay: text is updated only a few times per second
+    bool                      m_ShowOverlay    = false;
+    uint32_t                  m_LastOverlayMs  = 0;
+    std::vector<SDL_Texture*> m_OverlayLines;
+    std::vector<SDL_Rect>     m_OverlayRects;
+};
+
+// ==================================================================
+// a scoped zone: is opened in constructor and closed in destructor
+// ==================================================================
+class ProfileScope
+{
+public:
+    ProfileScope(const char* name, const bool isWait = false);
+    ~ProfileScope();
+
+private:
+    const char* m_Name;
+    uint64_t    m_StartTicks;
+    bool        m_IsProfiled;       // the zone is opened on a thread with its own tree
+};
+
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b)      PROFILE_CONCAT_IMPL(a, b)
+
+#if ENABLE_PROFILER
+    #define PROFILE_ZONE(name)    ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(name)
+
+    // the thread only waits for another one (this time is already in the tree of that
+    // thread), so such a zone is never reported as the slowest phase of the frame
+    #define PROFILE_WAIT_ZONE(name)    ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(name, true)
+#else
+    #define PROFILE_ZONE(name)
+    #define PROFILE_WAIT_ZONE(name)
+#endif
+
+// ==================================================================
+// Declare a global instance of the profiler
+// ==================================================================
+extern Profiler g_Profiler;
+
+#endif
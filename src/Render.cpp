@@ -5,6 +5,7 @@
 // Created:     15.04.2025 by DimaSkup
 // ==================================================================
 #include "Render.h"
+#include "RenderSnapshot.h"
 #include "Log.h"
 #include <SDL2/SDL_ttf.h>
 
@@ -22,10 +23,19 @@ int Render::ms_WndHeight = 600;
 bool Render::Initialize(
     const int wndWidth,       // window width for windowed mode
     const int wndHeight,      // window height for windowed mode
-    const bool isFullscreen)
+    const bool isFullscreen,
+    const bool isHeadless)    // no real window and audio device (for benchmarks on CI)
 {
     LogMsg(LOG, "Start of the game initialization");
 
+    // the drivers must be chosen before SDL is initialized
+    if (isHeadless)
+    {
+        SDL_setenv("SDL_VIDEODRIVER", "dummy", 1);
+        SDL_setenv("SDL_AUDIODRIVER", "dummy", 1);
+        LogMsg(LOG, "headless mode: dummy video/audio drivers");
+    }
+
     if (SDL_Init(SDL_INIT_EVERYTHING) != 0)
     {
         LogErr(LOG, "Error initializing SDL");
@@ -43,7 +53,7 @@ bool Render::Initialize(
 
     SetConsoleColor(CYAN);
 
-    if (isFullscreen)
+    if (isFullscreen && !isHeadless)
     {
         // use SDL to query what is the fullscreen max width and height
         SDL_DisplayMode displayMode;
@@ -77,7 +87,7 @@ bool Render::Initialize(
         SDL_WINDOWPOS_CENTERED,
         width,
         height,
-        SDL_WINDOW_BORDERLESS);
+        isHeadless ? SDL_WINDOW_HIDDEN : SDL_WINDOW_BORDERLESS);
 
     if (g_pWindow == nullptr)
     {
@@ -86,7 +96,8 @@ bool Render::Initialize(
     }
    
     // create a SDL renderer 
-    g_pRenderer = SDL_CreateRenderer(g_pWindow, -1, 0);
+    // (the dummy video driver has only the software renderer)
+    g_pRenderer = SDL_CreateRenderer(g_pWindow, -1, isHeadless ? SDL_RENDERER_SOFTWARE : 0);
     if (g_pRenderer == nullptr)
     {
         LogErr(LOG, "Error initializing renderer");
@@ -94,7 +105,7 @@ bool Render::Initialize(
     }
 
     // go to the fullscreen mode and hide cursor
-    if (isFullscreen)
+    if (isFullscreen && !isHeadless)
     {
         SDL_SetWindowFullscreen(g_pWindow, SDL_WINDOW_FULLSCREEN);
         SDL_ShowCursor(SDL_DISABLE);
@@ -161,3 +172,21 @@ void Render::DrawRectTextured(
 
     SDL_RenderCopyEx(g_pRenderer, pTexture, &srcRect, &dstRect, 0.0, NULL, flip); 
 }
+
+//---------------------------------------------------------
+// Desc:   replay draw commands of the frame's snapshot in sorted order
+//         (the buffer is sorted by the simulation), and then UI over it
+//---------------------------------------------------------
+void Render::DrawSnapshot(const RenderSnapshot& snapshot)
+{
+    const RenderCommandBuffer& commands = snapshot.commands;
+
+    for (int i = 0; i < commands.GetNumCommands(); ++i)
+    {
+        const RenderItem& item = commands.GetSorted(i);
+        DrawRectTextured(item.pTexture, item.srcRect, item.dstRect, item.flip);
+    }
+
+    for (const RenderItem& item : snapshot.uiItems)
+        DrawRectTextured(item.pTexture, item.srcRect, item.dstRect, item.flip);
+}
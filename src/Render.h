@@ -10,13 +10,16 @@
 
 #include <SDL2/SDL.h>
 
+struct RenderSnapshot;
+
 class Render
 {
 public:
     bool Initialize(
         const int wndWidth, 
         const int wndHeight,
-        const bool isFullscreen);
+        const bool isFullscreen,
+        const bool isHeadless = false);
 
     void Shutdown();
 
@@ -36,6 +39,8 @@ public:
         const SDL_Rect& dstRect,
         const SDL_RendererFlip& flip);
 
+    static void DrawSnapshot(const RenderSnapshot& snapshot);
+
     void Begin();   // clear the screen before the next frame
     void End();     // present all the rendered stuff onto the screen
 
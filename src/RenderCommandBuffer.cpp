@@ -0,0 +1,70 @@
+// ==================================================================
+// Filename:    RenderCommandBuffer.cpp
+// Created:     19.10.2026 by DimaSkup
+// ==================================================================
+#include "RenderCommandBuffer.h"
+#include <utility>
+
+
+//---------------------------------------------------------
+// Desc:   remove all the commands (keep the memory for the next frame)
+//---------------------------------------------------------
+void RenderCommandBuffer::Clear()
+{
+    m_Items.clear();
+    m_Keys.clear();
+    m_NumCulled = 0;
+}
+
+//---------------------------------------------------------
+// Desc:   sort commands by their keys: LSD radix sort by 8-bit digits;
+//         histograms of all the digits are computed in one pass, and
+//         a pass is skipped if all the keys have the same digit (the low
+//         unused bits, the same layer or no depth, etc.) so usually
+//         only 3-5 passes of 8 are really executed
+//---------------------------------------------------------
+void RenderCommandBuffer::Sort()
+{
+    constexpr int NUM_PASSES = sizeof(uint64_t);
+    constexpr int NUM_BINS   = 256;
+
+    const uint32_t numKeys = (uint32_t)m_Keys.size();
+
+    if (numKeys < 2)
+        return;
+
+    uint32_t histograms[NUM_PASSES][NUM_BINS] = {};
+
+    for (const SortKey& k : m_Keys)
+    {
+        for (int pass = 0; pass < NUM_PASSES; ++pass)
+            histograms[pass][(k.key >> (pass * 8)) & 0xFF]++;
+    }
+
+    m_TmpKeys.resize(numKeys);
+
+    for (int pass = 0; pass < NUM_PASSES; ++pass)
+    {
+        const int shift     = pass * 8;
+        uint32_t* histogram = histograms[pass];
+
+        // all the keys have the same digit: the order wouldn't change
+        if (histogram[(m_Keys[0].key >> shift) & 0xFF] == numKeys)
+            continue;
+
+        // offset of each bin in the output
+        uint32_t offset = 0;
+
+        for (int bin = 0; bin < NUM_BINS; ++bin)
+        {
+            const uint32_t count = histogram[bin];
+            histogram[bin] = offset;
+            offset += count;
+        }
+
+        for (const SortKey& k : m_Keys)
+            m_TmpKeys[histogram[(k.key >> shift) & 0xFF]++] = k;
+
+        std::swap(m_Keys, m_TmpKeys);
+    }
+}
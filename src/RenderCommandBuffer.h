@@ -0,0 +1,113 @@
+// ==================================================================
+// Filename:    RenderCommandBuffer.h
+// Description: a per-frame linear buffer of draw commands: components
+//              don't draw anything, they add a command (a texture and
+//              src/dst rects) with a 64-bit sort key:
+//
+//              | 63..60 | 59..40  | 39..24     | 23..0  |
+//              | layer  | y-depth | texture ID | unused |
+//
+//              so after sorting the commands are drawn by layers, inside
+//              a layer from the top of the screen to the bottom (objects
+//              which are lower are drawn over the upper ones), and the
+//              commands with the same depth are grouped by texture
+//              (tiles have no depth so the whole tilemap is grouped);
+//
+//              the buffer is sorted by LSD radix sort (stable, so equal
+//              keys keep the order of submission) and the memory is reused
+//              from frame to frame
+//
+// Created:     19.10.2026 by DimaSkup
+// ==================================================================
+#ifndef RENDER_COMMAND_BUFFER_H
+#define RENDER_COMMAND_BUFFER_H
+
+#include "Types.h"
+#include <SDL2/SDL.h>
+#include <vector>
+#include <stdint.h>
+
+constexpr int RENDER_KEY_LAYER_SHIFT   = 60;
+constexpr int RENDER_KEY_DEPTH_SHIFT   = 40;
+constexpr int RENDER_KEY_TEXTURE_SHIFT = 24;
+constexpr int RENDER_KEY_DEPTH_MAX     = (1 << 20) - 1;
+constexpr int RENDER_KEY_DEPTH_BIAS    = 1 << 19;       // screen Y can be negative
+
+// AABB and other debug stuff are over all the layers of entities
+constexpr int RENDER_LAYER_DEBUG       = NUM_LAYERS;
+
+//---------------------------------------------------------
+// Desc:   build a sort key of the draw command
+// Args:   - layer:     eLayerType or RENDER_LAYER_DEBUG
+//         - depth:     screen Y of the bottom of the object (0 if no depth)
+//         - textureID: see AssetMgr::GetTextureID() (0 if unknown)
+//---------------------------------------------------------
+inline uint64_t MakeRenderKey(const int layer, const int depth, const uint16_t textureID)
+{
+    int biasedDepth = depth + RENDER_KEY_DEPTH_BIAS;
+
+    if (biasedDepth < 0)
+        biasedDepth = 0;
+    else if (biasedDepth > RENDER_KEY_DEPTH_MAX)
+        biasedDepth = RENDER_KEY_DEPTH_MAX;
+
+    return ((uint64_t)layer       << RENDER_KEY_LAYER_SHIFT) |
+           ((uint64_t)biasedDepth << RENDER_KEY_DEPTH_SHIFT) |
+           ((uint64_t)textureID   << RENDER_KEY_TEXTURE_SHIFT);
+}
+
+// a payload of the draw command
+struct RenderItem
+{
+    SDL_Texture*     pTexture = nullptr;
+    SDL_Rect         srcRect;
+    SDL_Rect         dstRect;
+    SDL_RendererFlip flip     = SDL_FLIP_NONE;
+};
+
+///////////////////////////////////////////////////////////
+
+class RenderCommandBuffer
+{
+public:
+    RenderCommandBuffer() {}
+
+    void Clear();
+    void Sort();
+
+    inline void AddCommand(
+        const uint64_t sortKey,
+        SDL_Texture* pTexture,
+        const SDL_Rect& srcRect,
+        const SDL_Rect& dstRect,
+        const SDL_RendererFlip flip)
+    {
+        m_Keys.push_back({ sortKey, (uint32_t)m_Items.size() });
+        m_Items.push_back({ pTexture, srcRect, dstRect, flip });
+    }
+
+    // an off-screen renderable skipped its command (for statistics)
+    inline void AddCulled() { ++m_NumCulled; }
+
+    inline bool IsEmpty()        const { return m_Items.empty(); }
+    inline int  GetNumCommands() const { return (int)m_Items.size(); }
+    inline int  GetNumCulled()   const { return m_NumCulled; }
+
+    // get a command by index in sorted order (after Sort())
+    inline const RenderItem& GetSorted(const int i) const { return m_Items[m_Keys[i].idx]; }
+    inline uint64_t          GetSortedKey(const int i) const { return m_Keys[i].key; }
+
+private:
+    struct SortKey
+    {
+        uint64_t key;
+        uint32_t idx;       // an index of the command's payload
+    };
+
+    std::vector<RenderItem> m_Items;      // payloads in order of submission
+    std::vector<SortKey>    m_Keys;       // sorted by Sort()
+    std::vector<SortKey>    m_TmpKeys;    // a scratch buffer for the radix sort
+    int                     m_NumCulled = 0;
+};
+
+#endif
@@ -0,0 +1,31 @@
+// ==================================================================
+// Filename:    RenderSnapshot.h
+// Description: an immutable state of the frame for rendering: draw
+//              commands of everything which is drawn (see RenderCommandBuffer);
+//              it is filled by the simulation (entities, help screen, AABB)
+//              and by the main thread (UI text), and then it's drawn by
+//              the main thread without touching entities at all
+//              (so the simulation of the next frame can run meanwhile)
+//
+// Created:     19.10.2026 by DimaSkup
+// ==================================================================
+#ifndef RENDER_SNAPSHOT_H
+#define RENDER_SNAPSHOT_H
+
+#include "RenderCommandBuffer.h"
+#include <vector>
+
+struct RenderSnapshot
+{
+    RenderCommandBuffer     commands;   // the world: entities, AABB (sorted by the simulation)
+    std::vector<RenderItem> uiItems;    // text labels (over the world)
+    uint32_t                frameIdx = 0;
+
+    inline void Clear()
+    {
+        commands.Clear();
+        uiItems.clear();
+    }
+};
+
+#endif
@@ -7,15 +7,12 @@ SoundMgr g_SoundMgr;
 
 
 //---------------------------------------------------------
-// Desc: default constructor
+// Desc: default constructor; the audio device isn't opened here
+//       but in Initialize() when SDL drivers are already chosen
+//       (for instance, the dummy one in the headless mode)
 //---------------------------------------------------------
 SoundMgr::SoundMgr()
 {
-    if (Initialize() == -1)
-    {
-        LogErr(LOG, "can't initialize the sound manager");
-        exit(-1);
-    }
 }
 
 
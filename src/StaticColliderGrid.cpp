@@ -0,0 +1,16 @@
+// ==================================================================
+// Filename:    StaticColliderGrid.cpp
+// Created:     19.10.2026 by DimaSkup
+// ==================================================================
+#include "StaticColliderGrid.h"
+#include "Components/Collider.h"
+
+
+//---------------------------------------------------------
+// Desc:   a static collider never moves so its rect is taken only once
+//         (when the grid is built)
+//---------------------------------------------------------
+SDL_Rect StaticColliderGridTraits::GetRect(const Collider* pCollider)
+{
+    return pCollider->m_ColliderRect;
+}
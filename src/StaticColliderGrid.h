@@ -0,0 +1,32 @@
+// ==================================================================
+// Filename:    StaticColliderGrid.h
+// Description: an immutable uniform grid of static colliders
+//              (vegetation, obstacles, level complete zone, etc.);
+//              it is built only once when the level is loaded, so
+//              each frame we just query it by rects of dynamic colliders
+//
+// Created:     19.10.2026 by DimaSkup
+// ==================================================================
+#ifndef STATIC_COLLIDER_GRID_H
+#define STATIC_COLLIDER_GRID_H
+
+#include "UniformGrid.h"
+#include "Collision.h"
+
+class Collider;
+
+struct StaticColliderGridTraits
+{
+    static constexpr const char* NAME = "static colliders";
+
+    static SDL_Rect GetRect(const Collider* pCollider);
+
+    static inline bool IsOverlapped(const SDL_Rect& a, const SDL_Rect& b)
+    {
+        return Collision::CheckRectCollision(a, b);
+    }
+};
+
+using StaticColliderGrid = UniformGrid<const Collider*, StaticColliderGridTraits>;
+
+#endif
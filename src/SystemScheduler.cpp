@@ -0,0 +1,169 @@
+// ==================================================================
+// Filename:    SystemScheduler.cpp
+// Created:     19.10.2026 by DimaSkup
+// ==================================================================
+#include "SystemScheduler.h"
+#include "JobSystem.h"
+#include "TraceRecorder.h"
+#include "Log.h"
+
+
+//---------------------------------------------------------
+// Desc:   update components [begin, end) by the system
+//---------------------------------------------------------
+static void UpdateComponents(
+    const SystemDesc& system,
+    IComponent** ppComponents,
+    const int begin,
+    const int end,
+    const float deltaTime)
+{
+    TRACE_ZONE(system.name);
+
+    if (system.func)
+    {
+        system.func(ppComponents, begin, end, deltaTime);
+        return;
+    }
+
+    for (int i = begin; i < end; ++i)
+        ppComponents[i]->Update(deltaTime);
+}
+
+//---------------------------------------------------------
+// Desc:   check if two systems can't be executed at the same time:
+//         one of them writes what the other one reads or writes
+//         (each system reads and writes components of its own type)
+//---------------------------------------------------------
+static bool IsConflict(const SystemDesc& s1, const SystemDesc& s2)
+{
+    const ComponentMask reads1  = s1.reads  | ComponentBit(s1.type);
+    const ComponentMask writes1 = s1.writes | ComponentBit(s1.type);
+    const ComponentMask reads2  = s2.reads  | ComponentBit(s2.type);
+    const ComponentMask writes2 = s2.writes | ComponentBit(s2.type);
+
+    return (writes1 & (reads2 | writes2)) || (reads1 & writes2);
+}
+
+//---------------------------------------------------------
+// Desc:   register a system; systems which conflict are executed
+//         in order of registration
+// Ret:    an index of the system or -1 if it's invalid
+//---------------------------------------------------------
+int SystemScheduler::AddSystem(const SystemDesc& desc)
+{
+    if (desc.type >= NUM_COMPONENT_TYPES)
+    {
+        LogErr(LOG, "can't add a system (%s): invalid component type: %d", desc.name, (int)desc.type);
+        return -1;
+    }
+
+    if ((int)m_Systems.size() >= SYSTEM_MAX_SYSTEMS)
+    {
+        LogErr(LOG, "can't add a system (%s): too many systems", desc.name);
+        return -1;
+    }
+
+    m_Systems.push_back(desc);
+    m_Stages.push_back(-1);
+    m_Types |= ComponentBit(desc.type);
+
+    return (int)m_Systems.size() - 1;
+}
+
+//---------------------------------------------------------
+// Desc:   build a dependency graph of systems which have components
+//         to update in this frame, and put each system into the stage
+//         right after the last stage of systems it depends on
+//---------------------------------------------------------
+void SystemScheduler::BuildStages(const ComponentLists& components)
+{
+    const int numSystems = (int)m_Systems.size();
+    m_NumStages = 0;
+
+    for (int j = 0; j < numSystems; ++j)
+    {
+        const SystemDesc& system = m_Systems[j];
+
+        if (components[system.type].empty())
+        {
+            m_Stages[j] = -1;
+            continue;
+        }
+
+        int stage = 0;
+
+        for (int i = 0; i < j; ++i)
+        {
+            if (m_Stages[i] >= stage && IsConflict(m_Systems[i], system))
+                stage = m_Stages[i] + 1;
+        }
+
+        m_Stages[j] = stage;
+        m_NumStages = (stage + 1 > m_NumStages) ? stage + 1 : m_NumStages;
+    }
+}
+
+//---------------------------------------------------------
+// Desc:   execute all the systems stage by stage: worker systems are
+//         submitted as jobs, main thread ones are executed right here,
+//         then we wait for the jobs before the next stage
+// Args:   - components: components of each type gathered for this frame
+//         - deltaTime:  the time passed since the previous frame
+//---------------------------------------------------------
+void SystemScheduler::Run(ComponentLists& components, const float deltaTime)
+{
+    BuildStages(components);
+
+    const int numSystems = (int)m_Systems.size();
+
+    for (int stage = 0; stage < m_NumStages; ++stage)
+    {
+        JobCounter counter;
+
+        for (int i = 0; i < numSystems; ++i)
+        {
+            const SystemDesc& system = m_Systems[i];
+
+            if (m_Stages[i] == stage && system.thread == SYSTEM_THREAD_ANY)
+                RunSystem(system, components[system.type], deltaTime, counter);
+        }
+
+        for (int i = 0; i < numSystems; ++i)
+        {
+            const SystemDesc& system = m_Systems[i];
+            std::vector<IComponent*>& comps = components[system.type];
+
+            if (m_Stages[i] == stage && system.thread == SYSTEM_THREAD_MAIN)
+                UpdateComponents(system, comps.data(), 0, (int)comps.size(), deltaTime);
+        }
+
+        g_JobSystem.Wait(counter);
+    }
+}
+
+//---------------------------------------------------------
+// Desc:   submit jobs of the system: a job per chunk of components
+//         if the system is parallel, or a single job otherwise
+//---------------------------------------------------------
+void SystemScheduler::RunSystem(
+    const SystemDesc& system,
+    std::vector<IComponent*>& components,
+    const float deltaTime,
+    JobCounter& counter)
+{
+    const SystemDesc* pSystem      = &system;
+    IComponent**      ppComponents = components.data();
+    const int         numItems     = (int)components.size();
+    const int         chunkSize    = (system.isParallel) ? SYSTEM_CHUNK_SIZE : numItems;
+
+    for (int begin = 0; begin < numItems; begin += chunkSize)
+    {
+        const int end = (begin + chunkSize < numItems) ? begin + chunkSize : numItems;
+
+        g_JobSystem.Submit(counter, [pSystem, ppComponents, begin, end, deltaTime]()
+        {
+            UpdateComponents(*pSystem, ppComponents, begin, end, deltaTime);
+        });
+    }
+}
@@ -0,0 +1,102 @@
+// ==================================================================
+// Filename:    SystemScheduler.h
+// Description: update logic of components is registered as systems
+//              (movement, animation, collider sync, etc.); each system
+//              goes through all the components of one type and declares
+//              which component types it reads and writes;
+//
+//              each frame the scheduler builds a dependency graph of
+//              systems which have anything to update: a system depends on
+//              each previous (by registration order) system it conflicts
+//              with (one writes what the other one reads or writes);
+//              systems are split into stages by these dependencies, and
+//              the systems of one stage are executed concurrently
+//              over the job system:
+//              - a parallel system is split by chunks of components
+//              - a main thread system (uses events, timers, input, etc.)
+//                is executed by the calling thread
+//
+//              so the result is the same as updating each entity's
+//              components in order (Transform, Sprite, Collider, ...)
+//              as long as systems are registered in this order, and
+//              a component only touches components of its own entity
+//
+// Created:     19.10.2026 by DimaSkup
+// ==================================================================
+#ifndef SYSTEM_SCHEDULER_H
+#define SYSTEM_SCHEDULER_H
+
+#include "IComponent.h"
+#include <vector>
+#include <stdint.h>
+
+struct JobCounter;
+
+constexpr int SYSTEM_MAX_SYSTEMS = 32;
+constexpr int SYSTEM_CHUNK_SIZE  = 256;     // components per job of a parallel system
+
+// a set of component types (a bit per eComponentType)
+using ComponentMask = uint32_t;
+
+inline constexpr ComponentMask ComponentBit(const eComponentType type)
+{
+    return (ComponentMask)1 << type;
+}
+
+// updates components [begin, end) of the input array;
+// if there is no function the virtual IComponent::Update is called
+using SystemFunc = void(*)(IComponent** ppComponents, const int begin, const int end, const float deltaTime);
+
+enum eSystemThread
+{
+    SYSTEM_THREAD_ANY,          // can be executed by any worker
+    SYSTEM_THREAD_MAIN,         // only by the thread which calls Run()
+};
+
+struct SystemDesc
+{
+    const char*    name       = "";
+    eComponentType type       = COMPONENT_UNKNOWN;   // components of this type are updated
+    ComponentMask  reads      = 0;                   // other types which are read
+    ComponentMask  writes     = 0;                   // other types which are written
+    eSystemThread  thread     = SYSTEM_THREAD_ANY;
+    bool           isParallel = false;               // components are independent so can be split by chunks
+    SystemFunc     func       = nullptr;
+};
+
+// components of each type gathered for the current frame (in entities order)
+using ComponentLists = std::vector<IComponent*>[NUM_COMPONENT_TYPES];
+
+///////////////////////////////////////////////////////////
+
+class SystemScheduler
+{
+public:
+    SystemScheduler() {}
+
+    int  AddSystem(const SystemDesc& desc);
+    void Run(ComponentLists& components, const float deltaTime);
+
+    inline bool HasSystem(const eComponentType type) const
+    {   return (m_Types & ComponentBit(type)) != 0;   }
+
+    inline int GetNumSystems() const { return (int)m_Systems.size(); }
+    inline int GetNumStages()  const { return m_NumStages; }
+
+private:
+    void BuildStages(const ComponentLists& components);
+
+    void RunSystem(
+        const SystemDesc& system,
+        std::vector<IComponent*>& components,
+        const float deltaTime,
+        JobCounter& counter);
+
+private:
+    std::vector<SystemDesc> m_Systems;
+    std::vector<int>        m_Stages;             // a stage of each system for the current frame (-1: nothing to update)
+    ComponentMask           m_Types = 0;          // types which have a system
+    int                     m_NumStages = 0;
+};
+
+#endif
@@ -10,6 +10,16 @@ TextureMgr g_TextureMgr;
 ///////////////////////////////////////////////////////////
 
 SDL_Texture* TextureMgr::LoadTexture(const char* fileName)
+{
+    SDL_Surface* pSurface = LoadSurface(fileName);
+
+    return (pSurface) ? CreateTexture(pSurface) : nullptr;
+}
+
+//---------------------------------------------------------
+// Desc:   load an image from the file (can be called from any thread)
+//---------------------------------------------------------
+SDL_Surface* TextureMgr::LoadSurface(const char* fileName)
 {
     if (!FileSys::Exists(fileName))
     {
@@ -17,10 +27,17 @@ SDL_Texture* TextureMgr::LoadTexture(const char* fileName)
         return nullptr;
     }
 
-    SDL_Surface* pSurface = IMG_Load(fileName);
+    return IMG_Load(fileName);
+}
+
+//---------------------------------------------------------
+// Desc:   create a texture from the surface and release the surface
+//         (only on the main thread since it uses the renderer)
+//---------------------------------------------------------
+SDL_Texture* TextureMgr::CreateTexture(SDL_Surface* pSurface)
+{
     SDL_Texture* pTexture = SDL_CreateTextureFromSurface(g_pRenderer, pSurface);
     SDL_FreeSurface(pSurface);
 
     return pTexture;
 }
-
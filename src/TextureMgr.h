@@ -12,7 +12,9 @@
 class TextureMgr
 {
 public:
-    static SDL_Texture* LoadTexture(const char* fileName);
+    static SDL_Texture* LoadTexture  (const char* fileName);
+    static SDL_Surface* LoadSurface  (const char* fileName);
+    static SDL_Texture* CreateTexture(SDL_Surface* pSurface);
 };
 
 // ==================================================================
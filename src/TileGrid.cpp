@@ -0,0 +1,19 @@
+// ==================================================================
+// Filename:    TileGrid.cpp
+// Created:     19.10.2026 by DimaSkup
+// ==================================================================
+#include "TileGrid.h"
+#include "Components/TileComponent.h"
+
+
+//---------------------------------------------------------
+// Desc:   a rect of the tile in world space (its dst rect is in screen space)
+//---------------------------------------------------------
+SDL_Rect TileGridTraits::GetRect(const TileComponent* pTile)
+{
+    return {
+        (int)pTile->m_Position.x,
+        (int)pTile->m_Position.y,
+        pTile->m_DstRect.w,
+        pTile->m_DstRect.h };
+}
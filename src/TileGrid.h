@@ -0,0 +1,35 @@
+// ==================================================================
+// Filename:    TileGrid.h
+// Description: an immutable uniform grid of tiles of the level map;
+//              tiles never move so it is built only once when the level
+//              is loaded, and each frame we query it by the camera rect
+//              to get only the visible tiles (so off-screen tiles are
+//              neither updated nor submitted for rendering)
+//
+// Created:     19.10.2026 by DimaSkup
+// ==================================================================
+#ifndef TILE_GRID_H
+#define TILE_GRID_H
+
+#include "UniformGrid.h"
+
+class TileComponent;
+
+struct TileGridTraits
+{
+    static constexpr const char* NAME = "tile";
+
+    static SDL_Rect GetRect(const TileComponent* pTile);
+
+    // touching by an edge isn't an overlap, so a tile right next
+    // to the screen border isn't visible
+    static inline bool IsOverlapped(const SDL_Rect& a, const SDL_Rect& b)
+    {
+        return (a.x < b.x + b.w) && (b.x < a.x + a.w) &&
+               (a.y < b.y + b.h) && (b.y < a.y + a.h);
+    }
+};
+
+using TileGrid = UniformGrid<TileComponent*, TileGridTraits>;
+
+#endif
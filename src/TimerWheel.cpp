@@ -0,0 +1,216 @@
+// ==================================================================
+// Filename:    TimerWheel.cpp
+// Created:     19.10.2026 by DimaSkup
+// ==================================================================
+#include "TimerWheel.h"
+
+// init a global instance of the timer wheel
+TimerWheel g_TimerWheel;
+
+
+///////////////////////////////////////////////////////////
+
+TimerWheel::TimerWheel()
+{
+    Clear();
+}
+
+//---------------------------------------------------------
+// Desc:   cancel a scheduled timer
+// Args:   - id:  an ID which was returned when the timer was scheduled
+// Ret:    false if there is no such timer (already fired or canceled)
+//---------------------------------------------------------
+bool TimerWheel::Cancel(const TimerID id)
+{
+    const uint32_t idx = (uint32_t)(id & 0xFFFFFFFF);
+    const uint32_t gen = (uint32_t)(id >> 32);
+
+    if (id == INVALID_TIMER_ID || idx >= (uint32_t)m_Timers.size())
+        return false;
+
+    Timer& timer = m_Timers[idx];
+
+    if (timer.gen != gen || !timer.pSlotHead)
+        return false;
+
+    Unlink(idx);
+    FreeTimer(idx);
+    return true;
+}
+
+//---------------------------------------------------------
+// Desc:   move the wheel forward tick by tick and fire expired timers
+// Args:   - deltaMs:  the time passed since the prev call
+//---------------------------------------------------------
+void TimerWheel::Advance(const uint32_t deltaMs)
+{
+    for (uint32_t i = 0; i < deltaMs; ++i)
+    {
+        m_CurrTick++;
+
+        // when a lower level wraps around we move timers from
+        // the current slot of the next level down
+        for (int level = 1; level < NUM_LEVELS; ++level)
+        {
+            if ((m_CurrTick >> ((level-1) * SLOT_BITS)) & SLOT_MASK)
+                break;
+
+            Cascade(level);
+        }
+
+        // fire all the timers of the current slot
+        int& head = m_Slots[0][m_CurrTick & SLOT_MASK];
+        int  idx  = head;
+        head = -1;
+
+        while (idx != -1)
+        {
+            Timer& timer = m_Timers[idx];
+            const int next = timer.next;
+
+            timer.pSlotHead = nullptr;
+            timer.fire(timer.payload);
+            FreeTimer(idx);
+
+            idx = next;
+        }
+    }
+}
+
+//---------------------------------------------------------
+// Desc:   drop all the timers (for instance when a level is reloaded)
+//---------------------------------------------------------
+void TimerWheel::Clear()
+{
+    for (int level = 0; level < NUM_LEVELS; ++level)
+        for (int slot = 0; slot < NUM_SLOTS; ++slot)
+            m_Slots[level][slot] = -1;
+
+    // release all the timers (so their IDs become invalid)
+    m_FreeHead = -1;
+
+    for (int i = (int)m_Timers.size() - 1; i >= 0; --i)
+    {
+        if (m_Timers[i].pSlotHead)
+            m_Timers[i].gen++;
+
+        m_Timers[i].pSlotHead = nullptr;
+        m_Timers[i].next      = m_FreeHead;
+        m_FreeHead            = i;
+    }
+
+    m_NumActive = 0;
+}
+
+//---------------------------------------------------------
+// Desc:   get a free timer from the pool (or add a new one)
+//---------------------------------------------------------
+int TimerWheel::AllocTimer()
+{
+    int idx = m_FreeHead;
+
+    if (idx != -1)
+    {
+        m_FreeHead = m_Timers[idx].next;
+    }
+    else
+    {
+        idx = (int)m_Timers.size();
+        m_Timers.push_back(Timer());
+    }
+
+    m_NumActive++;
+    return idx;
+}
+
+//---------------------------------------------------------
+// Desc:   return a timer into the pool; its old ID becomes invalid
+//---------------------------------------------------------
+void TimerWheel::FreeTimer(const int idx)
+{
+    Timer& timer    = m_Timers[idx];
+    timer.gen++;
+    timer.pSlotHead = nullptr;
+    timer.next      = m_FreeHead;
+    m_FreeHead      = idx;
+    m_NumActive--;
+}
+
+//---------------------------------------------------------
+// Desc:   compute expiration tick of the timer and put it into a slot;
+//         zero delay means the next tick
+//---------------------------------------------------------
+void TimerWheel::Schedule(const int idx, const uint32_t delayMs)
+{
+    m_Timers[idx].expireTick = m_CurrTick + ((delayMs > 0) ? delayMs : 1);
+    Insert(idx);
+}
+
+//---------------------------------------------------------
+// Desc:   put a timer into a slot of the level which
+//         covers the time left until its expiration
+//---------------------------------------------------------
+void TimerWheel::Insert(const int idx)
+{
+    Timer&         timer  = m_Timers[idx];
+    const uint64_t expire = timer.expireTick;
+    const uint64_t delta  = expire - m_CurrTick;
+    int*           pHead  = nullptr;
+
+    if (delta < (1ULL << SLOT_BITS))
+        pHead = &m_Slots[0][expire & SLOT_MASK];
+
+    else if (delta < (1ULL << (2*SLOT_BITS)))
+        pHead = &m_Slots[1][(expire >> SLOT_BITS) & SLOT_MASK];
+
+    else if (delta < (1ULL << (3*SLOT_BITS)))
+        pHead = &m_Slots[2][(expire >> (2*SLOT_BITS)) & SLOT_MASK];
+
+    else
+        pHead = &m_Slots[3][(expire >> (3*SLOT_BITS)) & SLOT_MASK];
+
+    timer.pSlotHead = pHead;
+    timer.prev      = -1;
+    timer.next      = *pHead;
+
+    if (*pHead != -1)
+        m_Timers[*pHead].prev = idx;
+
+    *pHead = idx;
+}
+
+//---------------------------------------------------------
+// Desc:   remove a timer from the list of its slot
+//---------------------------------------------------------
+void TimerWheel::Unlink(const int idx)
+{
+    Timer& timer = m_Timers[idx];
+
+    if (timer.prev != -1)
+        m_Timers[timer.prev].next = timer.next;
+    else
+        *timer.pSlotHead = timer.next;
+
+    if (timer.next != -1)
+        m_Timers[timer.next].prev = timer.prev;
+
+    timer.pSlotHead = nullptr;
+}
+
+//---------------------------------------------------------
+// Desc:   move timers of the current slot of the level
+//         into lower levels (by the time which is left)
+//---------------------------------------------------------
+void TimerWheel::Cascade(const int level)
+{
+    int& head = m_Slots[level][(m_CurrTick >> (level * SLOT_BITS)) & SLOT_MASK];
+    int  idx  = head;
+    head = -1;
+
+    while (idx != -1)
+    {
+        const int next = m_Timers[idx].next;
+        Insert(idx);
+        idx = next;
+    }
+}
@@ -0,0 +1,112 @@
+// ==================================================================
+// Filename:    TimerWheel.h
+// Description: a hierarchical timing wheel to schedule something
+//              once instead of polling it each frame (for instance:
+//              "destroy entity X in 1200 ms"):
+//              - 4 levels by 256 slots, the tick is 1 ms
+//              - level 0 holds timers which expire during the next 256 ticks,
+//                higher levels hold further timers by coarser slots;
+//                when a lower level wraps around, a slot of the higher
+//                level is cascaded down
+//              - schedule/cancel is O(1), expiry is O(1) amortized
+//
+//              NOTE: timers fire events into the event manager so
+//                    they are handled at the next dispatch
+//
+// Created:     19.10.2026 by DimaSkup
+// ==================================================================
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include "EventMgr.h"
+#include <vector>
+#include <string.h>
+#include <stdint.h>
+#include <type_traits>
+
+using TimerID = uint64_t;                     // index of timer + its generation
+constexpr TimerID INVALID_TIMER_ID = 0;
+
+class TimerWheel
+{
+public:
+    TimerWheel();
+
+    //-----------------------------------------------------
+    // Desc:  schedule an event which will be added into
+    //        the event manager after delay
+    // Args:  - e:        an event to fire
+    //        - delayMs:  delay in milliseconds
+    // Ret:   an ID of the timer (to cancel it)
+    //-----------------------------------------------------
+    template <typename T>
+    TimerID ScheduleEvent(const T& e, const uint32_t delayMs)
+    {
+        static_assert(sizeof(T) <= TIMER_PAYLOAD_SIZE, "the event is too big for the timer");
+        static_assert(std::is_trivially_copyable<T>::value, "the event must be trivially copyable");
+
+        const int idx = AllocTimer();
+        Timer& timer  = m_Timers[idx];
+
+        memcpy(timer.payload, &e, sizeof(T));
+        timer.fire = [](const void* pPayload) { g_EventMgr.AddEvent(*(const T*)pPayload); };
+
+        Schedule(idx, delayMs);
+        return MakeID(idx, timer.gen);
+    }
+
+    inline TimerID ScheduleDestroy(const EntityID id, const uint32_t delayMs)
+    {
+        return ScheduleEvent(EventDestroyEntity(id), delayMs);
+    }
+
+    bool Cancel(const TimerID id);
+    void Advance(const uint32_t deltaMs);
+    void Clear();
+
+    inline int GetNumActiveTimers() const { return m_NumActive; }
+
+private:
+    static constexpr int NUM_LEVELS        = 4;
+    static constexpr int SLOT_BITS         = 8;
+    static constexpr int NUM_SLOTS         = 1 << SLOT_BITS;
+    static constexpr int SLOT_MASK         = NUM_SLOTS - 1;
+    static constexpr int TIMER_PAYLOAD_SIZE = 16;
+
+    using FireFunc = void (*)(const void* pPayload);
+
+    struct Timer
+    {
+        alignas(8) uint8_t payload[TIMER_PAYLOAD_SIZE];
+        FireFunc fire       = nullptr;
+        uint64_t expireTick = 0;
+        int      prev       = -1;           // in the list of slot (or free list)
+        int      next       = -1;
+        int*     pSlotHead  = nullptr;      // a slot where the timer is (nullptr if free)
+        uint32_t gen        = 1;            // is increased when the timer is released
+    };
+
+    inline static TimerID MakeID(const int idx, const uint32_t gen)
+    {   return ((uint64_t)gen << 32) | (uint32_t)idx;   }
+
+    int  AllocTimer();
+    void FreeTimer(const int idx);
+    void Schedule(const int idx, const uint32_t delayMs);
+    void Insert(const int idx);
+    void Unlink(const int idx);
+    void Cascade(const int level);
+
+private:
+    std::vector<Timer> m_Timers;
+    int                m_FreeHead  = -1;
+    int                m_NumActive = 0;
+    uint64_t           m_CurrTick  = 0;
+    int                m_Slots[NUM_LEVELS][NUM_SLOTS];    // heads of timers lists
+};
+
+// ==================================================================
+// Declare a global instance of the timer wheel
+// ==================================================================
+extern TimerWheel g_TimerWheel;
+
+#endif
@@ -0,0 +1,174 @@
+// ==================================================================
+// Filename:    TraceRecorder.cpp
+// Created:     19.10.2026 by DimaSkup
+// ==================================================================
+#include "TraceRecorder.h"
+#include "Log.h"
+#include <SDL2/SDL.h>
+#include <stdio.h>
+
+// init a global instance of the trace recorder
+TraceRecorder g_TraceRecorder;
+
+// a buffer of the current thread (is set on the first event)
+static thread_local void* t_pThreadBuffer = nullptr;
+
+
+///////////////////////////////////////////////////////////
+
+TraceRecorder::TraceRecorder()
+{
+    for (std::atomic<ThreadBuffer*>& pBuffer : m_Buffers)
+        pBuffer.store(nullptr, std::memory_order_relaxed);
+}
+
+TraceRecorder::~TraceRecorder()
+{
+    for (std::atomic<ThreadBuffer*>& pBuffer : m_Buffers)
+    {
+        delete pBuffer.load();
+        pBuffer.store(nullptr);
+    }
+}
+
+//---------------------------------------------------------
+// Desc:   add a zone into the ring of the current thread
+//         (the oldest events are overwritten)
+//---------------------------------------------------------
+void TraceRecorder::AddEvent(
+    const char* name,
+    const uint64_t startTicks,
+    const uint64_t endTicks)
+{
+    if (!IsEnabled())
+        return;
+
+    ThreadBuffer* pBuffer = GetThreadBuffer();
+
+    if (!pBuffer)
+        return;
+
+    const uint64_t idx = pBuffer->writeIdx.load(std::memory_order_relaxed);
+    TraceEvent&    e   = pBuffer->events[idx & (TRACE_EVENTS_PER_THREAD-1)];
+
+    e.name       = name;
+    e.startTicks = startTicks;
+    e.endTicks   = endTicks;
+
+    pBuffer->writeIdx.store(idx + 1, std::memory_order_release);
+}
+
+//---------------------------------------------------------
+// Desc:   set a name of the current thread which is shown in the trace
+//---------------------------------------------------------
+void TraceRecorder::SetThreadName(const char* name)
+{
+    ThreadBuffer* pBuffer = GetThreadBuffer();
+
+    if (pBuffer)
+        pBuffer->name = name;
+}
+
+//---------------------------------------------------------
+// Desc:   write events of the last seconds from all the threads
+//         in the Chrome Trace Event format (complete "X" events)
+// Args:   - filename:     path to the output JSON file
+//         - lastSeconds:  how many recent seconds to write
+//---------------------------------------------------------
+bool TraceRecorder::DumpToFile(const char* filename, const float lastSeconds) const
+{
+    FILE* pFile = fopen(filename, "w");
+    if (!pFile)
+    {
+        LogErr(LOG, "can't open a file for the trace: %s", filename);
+        return false;
+    }
+
+    const double   usPerTick = 1000000.0 / (double)SDL_GetPerformanceFrequency();
+    const uint64_t now       = SDL_GetPerformanceCounter();
+    const uint64_t window    = (uint64_t)(lastSeconds * 1000000.0 / usPerTick);
+    const uint64_t minTicks  = (now > window) ? now - window : 0;
+    const int      numThreads = m_NumThreads.load(std::memory_order_acquire);
+
+    bool isFirst    = true;
+    int  numWritten = 0;
+
+    fprintf(pFile, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+    for (int t = 0; t < numThreads && t < TRACE_MAX_THREADS; ++t)
+    {
+        const ThreadBuffer* pBuffer = m_Buffers[t].load(std::memory_order_acquire);
+
+        if (!pBuffer)
+            continue;
+
+        // metadata: a name of the thread
+        fprintf(pFile, "%s{\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"name\":\"thread_name\",\"args\":{\"name\":\"%s\"}}",
+            isFirst ? "" : ",\n",
+            pBuffer->tid,
+            pBuffer->name ? pBuffer->name : "thread");
+        isFirst = false;
+
+        const uint64_t end   = pBuffer->writeIdx.load(std::memory_order_acquire);
+        const uint64_t begin = (end > TRACE_EVENTS_PER_THREAD) ? end - TRACE_EVENTS_PER_THREAD : 0;
+
+        for (uint64_t i = begin; i < end; ++i)
+        {
+            const TraceEvent& e = pBuffer->events[i & (TRACE_EVENTS_PER_THREAD-1)];
+
+            if (e.startTicks < minTicks)
+                continue;
+
+            fprintf(pFile, ",\n{\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"name\":\"%s\",\"ts\":%.3f,\"dur\":%.3f}",
+                pBuffer->tid,
+                e.name,
+                (double)(e.startTicks - minTicks) * usPerTick,
+                (double)(e.endTicks - e.startTicks) * usPerTick);
+
+            numWritten++;
+        }
+    }
+
+    fprintf(pFile, "\n]}\n");
+    fclose(pFile);
+
+    LogMsg(LOG, "trace is dumped: %s (events: %d, last %.1f sec)", filename, numWritten, lastSeconds);
+    return true;
+}
+
+//---------------------------------------------------------
+// Desc:   get a buffer of the current thread or register a new one
+// Ret:    nullptr if there are too many threads
+//---------------------------------------------------------
+TraceRecorder::ThreadBuffer* TraceRecorder::GetThreadBuffer()
+{
+    if (t_pThreadBuffer)
+        return (ThreadBuffer*)t_pThreadBuffer;
+
+    const int idx = m_NumThreads.fetch_add(1, std::memory_order_relaxed);
+
+    if (idx >= TRACE_MAX_THREADS)
+        return nullptr;
+
+    ThreadBuffer* pBuffer = new ThreadBuffer();
+    pBuffer->tid = idx;
+
+    m_Buffers[idx].store(pBuffer, std::memory_order_release);
+    t_pThreadBuffer = pBuffer;
+
+    return pBuffer;
+}
+
+//==================================================================
+// TraceScope
+//==================================================================
+TraceScope::TraceScope(const char* name) :
+    m_Name(name),
+    m_StartTicks(SDL_GetPerformanceCounter())
+{
+}
+
+TraceScope::~TraceScope()
+{
+    g_TraceRecorder.AddEvent(m_Name, m_StartTicks, SDL_GetPerformanceCounter());
+}
@@ -0,0 +1,88 @@
+// ==================================================================
+// Filename:    TraceRecorder.h
+// Description: records timings of zones from all the threads to
+//              inspect frame spikes offline:
+//              - each thread writes into its own ring buffer (it is
+//                registered on the first event), so writing is lock-free:
+//                only the owner thread writes and moves the write index
+//              - a zone is stored as one event with begin/end ticks
+//              - the last N seconds can be dumped into a file in the Chrome
+//                Trace Event JSON format (open in chrome://tracing or Perfetto)
+//
+//              NOTE: dump it when the workers are idle (for instance at
+//                    the end of frame), otherwise it can miss the latest events
+//
+// Created:     19.10.2026 by DimaSkup
+// ==================================================================
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#include <atomic>
+#include <stdint.h>
+
+constexpr int TRACE_MAX_THREADS       = 32;
+constexpr int TRACE_EVENTS_PER_THREAD = 1 << 16;     // power of 2
+
+class TraceRecorder
+{
+public:
+    TraceRecorder();
+    ~TraceRecorder();
+
+    void AddEvent(const char* name, const uint64_t startTicks, const uint64_t endTicks);
+    void SetThreadName(const char* name);
+
+    bool DumpToFile(const char* filename, const float lastSeconds) const;
+
+    inline void SetEnabled(const bool state) { m_IsEnabled.store(state, std::memory_order_relaxed); }
+    inline bool IsEnabled() const            { return m_IsEnabled.load(std::memory_order_relaxed); }
+
+private:
+    struct TraceEvent
+    {
+        const char* name       = nullptr;   // a string literal
+        uint64_t    startTicks = 0;
+        uint64_t    endTicks   = 0;
+    };
+
+    struct ThreadBuffer
+    {
+        TraceEvent            events[TRACE_EVENTS_PER_THREAD];
+        std::atomic<uint64_t> writeIdx{0};
+        const char*           name  = nullptr;
+        int                   tid   = 0;
+    };
+
+    ThreadBuffer* GetThreadBuffer();
+
+private:
+    std::atomic<ThreadBuffer*> m_Buffers[TRACE_MAX_THREADS];
+    std::atomic<int>           m_NumThreads{0};
+    std::atomic<bool>          m_IsEnabled{true};
+};
+
+// ==================================================================
+// a scoped zone for the trace only (for worker threads;
+// on the main thread PROFILE_ZONE adds trace events as well)
+// ==================================================================
+class TraceScope
+{
+public:
+    TraceScope(const char* name);
+    ~TraceScope();
+
+private:
+    const char* m_Name;
+    uint64_t    m_StartTicks;
+};
+
+#define TRACE_CONCAT_IMPL(a, b) a##b
+#define TRACE_CONCAT(a, b)      TRACE_CONCAT_IMPL(a, b)
+#define TRACE_ZONE(name)        TraceScope TRACE_CONCAT(traceScope_, __LINE__)(name)
+
+// ==================================================================
+// Declare a global instance of the trace recorder
+// ==================================================================
+extern TraceRecorder g_TraceRecorder;
+
+#endif
@@ -21,6 +21,7 @@ enum eColliderTag
     PROJECTILE           = 3,
     FRIENDLY_PROJECTILE  = 4,
     LEVEL_COMPLETE       = 5,
+    VEGETATION           = 6,
 };
 
 enum eCollisionType 
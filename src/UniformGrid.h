@@ -0,0 +1,208 @@
+// ==================================================================
+// Filename:    UniformGrid.h
+// Description: an immutable uniform grid of items which never move
+//              (static colliders, tiles of the level map, etc.):
+//              it is built only once when the level is loaded, so each
+//              frame we just query it by some rect; queries don't modify
+//              the grid so they are thread-safe
+//
+//              cells are stored in the CSR layout: items of all the cells
+//              are in one array, and each cell is a range of it
+//
+//              TItemPtr - a pointer to item (can be ptr to const)
+//              TTraits  - describes items:
+//                  static SDL_Rect GetRect(const TItemPtr pItem);  // in world space
+//                  static bool     IsOverlapped(const SDL_Rect& a, const SDL_Rect& b);
+//
+// Created:     19.10.2026 by DimaSkup
+// ==================================================================
+#ifndef UNIFORM_GRID_H
+#define UNIFORM_GRID_H
+
+#include "Types.h"
+#include "Log.h"
+#include <SDL2/SDL.h>
+#include <vector>
+
+template <typename TItemPtr, typename TTraits>
+class UniformGrid
+{
+public:
+    //-----------------------------------------------------
+    // Desc:   build the grid from the input items;
+    //         each item is put into every cell which it overlaps
+    // Args:   - items:       items of the level
+    //         - levelWidth:  width of the level in pixels
+    //         - levelHeight: height of the level in pixels
+    //-----------------------------------------------------
+    void Build(
+        const std::vector<TItemPtr>& items,
+        const int levelWidth,
+        const int levelHeight)
+    {
+        Clear();
+
+        if (items.empty())
+            return;
+
+        m_NumCellsX = (levelWidth  > 0) ? (levelWidth  + CELL_SIZE - 1) / CELL_SIZE : 1;
+        m_NumCellsY = (levelHeight > 0) ? (levelHeight + CELL_SIZE - 1) / CELL_SIZE : 1;
+
+        const int numCells = m_NumCellsX * m_NumCellsY;
+
+        m_Items.assign(items.begin(), items.end());
+        m_Rects.resize(items.size());
+
+        for (int i = 0; i < (int)items.size(); ++i)
+            m_Rects[i] = TTraits::GetRect(items[i]);
+
+        // count the number of items per cell
+        m_CellStart.resize(numCells + 1, 0);
+
+        for (const SDL_Rect& rect : m_Rects)
+        {
+            int minX, minY, maxX, maxY;
+            GetCellsRange(rect, minX, minY, maxX, maxY);
+
+            for (int y = minY; y <= maxY; ++y)
+                for (int x = minX; x <= maxX; ++x)
+                    m_CellStart[y * m_NumCellsX + x + 1]++;
+        }
+
+        // prefix sum: so m_CellStart[i] is an offset of the cell's first item
+        for (int i = 0; i < numCells; ++i)
+            m_CellStart[i+1] += m_CellStart[i];
+
+        // fill in the cells with indices of items
+        std::vector<uint> writePos(m_CellStart.begin(), m_CellStart.end() - 1);
+        m_CellItems.resize(m_CellStart[numCells]);
+
+        for (uint idx = 0; idx < (uint)m_Rects.size(); ++idx)
+        {
+            int minX, minY, maxX, maxY;
+            GetCellsRange(m_Rects[idx], minX, minY, maxX, maxY);
+
+            for (int y = minY; y <= maxY; ++y)
+                for (int x = minX; x <= maxX; ++x)
+                    m_CellItems[writePos[y * m_NumCellsX + x]++] = idx;
+        }
+
+        LogMsg(LOG, "%s grid is built (items: %d, cells: %dx%d)",
+            TTraits::NAME, (int)m_Items.size(), m_NumCellsX, m_NumCellsY);
+    }
+
+    //-----------------------------------------------------
+    // Desc:   release all the data of the grid
+    //-----------------------------------------------------
+    void Clear()
+    {
+        m_Items.clear();
+        m_Rects.clear();
+        m_CellStart.clear();
+        m_CellItems.clear();
+        m_NumCellsX = 0;
+        m_NumCellsY = 0;
+    }
+
+    //-----------------------------------------------------
+    // Desc:   exclude an item from the grid (for instance when
+    //         its entity is destroyed); the grid layout isn't changed
+    // Args:   - pItem: an item to remove
+    //-----------------------------------------------------
+    void Remove(const TItemPtr pItem)
+    {
+        for (TItemPtr& pStored : m_Items)
+        {
+            if (pStored == pItem)
+            {
+                pStored = nullptr;
+                return;
+            }
+        }
+    }
+
+    //-----------------------------------------------------
+    // Desc:   get all the items which overlap the input rect;
+    //         an item can overlap several cells so we take it only in
+    //         the first cell which is shared by the item and the rect
+    // Args:   - rect:      a rectangle to test (in world space)
+    // Out:    - outItems:  found items (each one only once)
+    //-----------------------------------------------------
+    void Query(const SDL_Rect& rect, std::vector<TItemPtr>& outItems) const
+    {
+        outItems.clear();
+
+        if (m_Items.empty())
+            return;
+
+        int minX, minY, maxX, maxY;
+        GetCellsRange(rect, minX, minY, maxX, maxY);
+
+        for (int y = minY; y <= maxY; ++y)
+        {
+            for (int x = minX; x <= maxX; ++x)
+            {
+                const int cellIdx = y * m_NumCellsX + x;
+
+                for (uint i = m_CellStart[cellIdx]; i < m_CellStart[cellIdx+1]; ++i)
+                {
+                    const uint idx = m_CellItems[i];
+
+                    if (!m_Items[idx])
+                        continue;
+
+                    int itemMinX, itemMinY, itemMaxX, itemMaxY;
+                    GetCellsRange(m_Rects[idx], itemMinX, itemMinY, itemMaxX, itemMaxY);
+
+                    const int firstX = (itemMinX > minX) ? itemMinX : minX;
+                    const int firstY = (itemMinY > minY) ? itemMinY : minY;
+
+                    if (x != firstX || y != firstY)
+                        continue;
+
+                    if (TTraits::IsOverlapped(rect, m_Rects[idx]))
+                        outItems.push_back(m_Items[idx]);
+                }
+            }
+        }
+    }
+
+    inline bool IsEmpty()     const { return m_Items.empty(); }
+    inline uint GetNumItems() const { return m_Items.size(); }
+
+private:
+    //-----------------------------------------------------
+    // Desc:   compute a range of cells which are covered by the input rect
+    //         (the range is clamped to the grid dimensions)
+    //-----------------------------------------------------
+    void GetCellsRange(
+        const SDL_Rect& rect,
+        int& minX,
+        int& minY,
+        int& maxX,
+        int& maxY) const
+    {
+        minX = rect.x / CELL_SIZE;
+        minY = rect.y / CELL_SIZE;
+        maxX = (rect.x + rect.w) / CELL_SIZE;
+        maxY = (rect.y + rect.h) / CELL_SIZE;
+
+        minX = (minX < 0) ? 0 : (minX >= m_NumCellsX) ? m_NumCellsX-1 : minX;
+        minY = (minY < 0) ? 0 : (minY >= m_NumCellsY) ? m_NumCellsY-1 : minY;
+        maxX = (maxX < 0) ? 0 : (maxX >= m_NumCellsX) ? m_NumCellsX-1 : maxX;
+        maxY = (maxY < 0) ? 0 : (maxY >= m_NumCellsY) ? m_NumCellsY-1 : maxY;
+    }
+
+private:
+    static constexpr int CELL_SIZE = 256;        // in pixels
+
+    std::vector<TItemPtr> m_Items;               // nullptr if the item was removed
+    std::vector<SDL_Rect> m_Rects;               // a copy of items rects (to not jump by ptrs)
+    std::vector<uint>     m_CellStart;           // [numCells+1] offsets into the m_CellItems
+    std::vector<uint>     m_CellItems;           // indices into m_Items grouped by cells
+
+    int m_NumCellsX = 0;
+    int m_NumCellsY = 0;
+};
+
+#endif
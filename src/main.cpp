@@ -3,6 +3,144 @@
 #include "Game.h"
 #include "Render.h"
 #include "EntityMgr.h"
+#include "InputMgr.h"
+#include "Profiler.h"
+#include "TraceRecorder.h"
+#include "FrameStats.h"
+#include "FramePipeline.h"
+
+//---------------------------------------------------------
+// Desc:   simulate the next frame and fill its render snapshot
+//         (is called by the simulation thread of the pipeline;
+//         the thread has its own frame in the profiler)
+//---------------------------------------------------------
+static void SimulateFrame(void* pGame, RenderSnapshot& outSnapshot)
+{
+    Game* game = (Game*)pGame;
+
+    g_Profiler.BeginFrame("Simulation");
+
+    {
+        PROFILE_ZONE("Update");
+        game->Update();
+    }
+    {
+        PROFILE_ZONE("ExtractRenderState");
+        game->ExtractRenderState(outSnapshot);
+    }
+
+    g_Profiler.EndFrame();
+}
+
+//---------------------------------------------------------
+// Desc:   run the game on the main thread: input, update and
+//         rendering of each frame one after another
+//---------------------------------------------------------
+static void RunSerial(Game& game, Render& render)
+{
+    RenderSnapshot snapshot;
+    uint32_t       frameIdx = 0;
+
+    while (game.IsRunning())
+    {
+        g_Profiler.BeginFrame();
+
+        {
+            PROFILE_ZONE("ProcessInput");
+            game.ProcessInput();
+            g_InputMgr.TagFrameEvents(++frameIdx);
+        }
+        {
+            PROFILE_ZONE("Update");
+            game.Update();
+        }
+        {
+            PROFILE_ZONE("Render");
+            snapshot.Clear();
+            snapshot.frameIdx = frameIdx;
+            game.ExtractRenderState(snapshot);
+            game.UpdateUI(snapshot);
+
+            render.Begin();
+            game.Render(snapshot);
+        }
+        {
+            PROFILE_ZONE("Render::End");
+            render.End();
+        }
+
+        g_InputMgr.MeasureLatency(snapshot.frameIdx);
+        g_Profiler.EndFrame();
+        g_FrameStats.EndFrame();
+    }
+}
+
+//---------------------------------------------------------
+// Desc:   run the game as a pipeline: the simulation thread produces
+//         the frame N+1 while the main thread renders the frame N;
+//         input is processed at the sync point (the simulation is idle)
+//---------------------------------------------------------
+static void RunPipelined(Game& game, Render& render)
+{
+    FramePipeline pipeline;
+    pipeline.Start(SimulateFrame, &game);
+
+    // the first frame: there is nothing to render yet
+    game.ProcessInput();
+    g_InputMgr.TagFrameEvents(pipeline.GetNextFrameIdx());
+    pipeline.StartSimulation();
+
+    bool isSimulating = true;
+
+    while (isSimulating)
+    {
+        g_Profiler.BeginFrame();
+
+        {
+            PROFILE_WAIT_ZONE("WaitSimulation");
+            pipeline.WaitSimulation();
+        }
+        {
+            PROFILE_ZONE("Sync");
+            game.UpdateUI(pipeline.GetSimSnapshot());
+            pipeline.SwapSnapshots();
+        }
+
+        // the last simulated frame is still rendered
+        isSimulating = game.IsRunning();
+
+        if (isSimulating)
+        {
+            PROFILE_ZONE("ProcessInput");
+            game.ProcessInput();
+
+            // this input is presented only with the next frame
+            g_InputMgr.TagFrameEvents(pipeline.GetNextFrameIdx());
+
+            isSimulating = game.IsRunning();
+
+            if (isSimulating)
+                pipeline.StartSimulation();
+        }
+        {
+            PROFILE_ZONE("Render");
+            render.Begin();
+            game.Render(pipeline.GetRenderSnapshot());
+        }
+        {
+            PROFILE_ZONE("Render::End");
+            render.End();
+        }
+
+        g_InputMgr.MeasureLatency(pipeline.GetRenderSnapshot().frameIdx);
+        g_Profiler.EndFrame();
+        g_FrameStats.EndFrame();
+    }
+
+    pipeline.Stop();
+}
+
+///////////////////////////////////////////////////////////
 
 int main(int argc, char* args[])
 {
@@ -12,26 +150,32 @@ int main(int argc, char* args[])
         return -1;
     }
 
+    g_TraceRecorder.SetThreadName("main");
+
+    // the main thread's tree goes first in the profiler stats
+    g_Profiler.RegisterThread("Frame");
+
     Render render;
     Game game;
 
     constexpr bool isFullScreen = true;
+
+    game.ParseCommandLine(argc, args);
     
-    render.Initialize(WINDOW_WIDTH, WINDOW_HEIGHT, isFullScreen);
+    render.Initialize(WINDOW_WIDTH, WINDOW_HEIGHT, isFullScreen, game.IsHeadless());
     game.Initialize();
 
     LogMsg("Game is running...");
 
-    while (game.IsRunning())
-    {
-        game.ProcessInput();
-        game.Update();
+    if (game.IsPipelined())
+        RunPipelined(game, render);
+    else
+        RunSerial(game, render);
 
-        render.Begin();
-        game.Render();
-        render.End();
-    }
+    g_FrameStats.Report();
 
+    if (game.IsHeadless())
+        game.ReportBenchmark();
 
     game.Destroy();
     render.Shutdown();
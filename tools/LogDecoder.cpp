@@ -0,0 +1,185 @@
+// ==================================================================
+// Filename:    LogDecoder.cpp
+// Description: turns a binary log of the engine (--log-binary=<file>)
+//              back into text in the same format as dude_engine_log.txt
+//
+//              usage: ./log_decoder <log.bin> [output.txt]
+//              (the text is printed into stdout if there is no output file)
+//
+// Created:     19.10.2026 by DimaSkup
+// ==================================================================
+#include "../src/LogFormat.h"
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+// a place in code which is met in the log
+struct Site
+{
+    uint8_t     type = LOG_RECORD_PLAIN;
+    int32_t     codeLine = 0;
+    std::string fileName;
+    std::string funcName;
+    std::string format;
+};
+
+//---------------------------------------------------------
+// Desc:   read a value from the file
+//---------------------------------------------------------
+template <typename T>
+static bool Read(FILE* pFile, T& outValue)
+{
+    return fread(&outValue, sizeof(T), 1, pFile) == 1;
+}
+
+//---------------------------------------------------------
+// Desc:   read a string (u16 length + chars)
+//---------------------------------------------------------
+static bool ReadStr(FILE* pFile, std::string& outStr)
+{
+    uint16_t len = 0;
+
+    if (!Read(pFile, len))
+        return false;
+
+    outStr.resize(len);
+    return (len == 0) || (fread(&outStr[0], 1, len, pFile) == len);
+}
+
+//---------------------------------------------------------
+// Desc:   print a decoded message in the format of the text log
+//---------------------------------------------------------
+static void PrintMessage(FILE* pOut, const Site& site, const long clock, const char* text)
+{
+    const char* type = "";
+
+    switch (site.type)
+    {
+        case LOG_RECORD_PLAIN:
+            fprintf(pOut, "[%05ld] %s\n", clock, text);
+            return;
+
+        case LOG_RECORD_DBG:
+            type = "DEBUG:";
+            break;
+
+        case LOG_RECORD_ERR:
+            type = "ERROR:";
+            break;
+    }
+
+    fprintf(pOut, "[%05ld] %s %s: %s() (line: %d): %s\n",
+        clock, type, site.fileName.c_str(), site.funcName.c_str(), site.codeLine, text);
+}
+
+///////////////////////////////////////////////////////////
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        printf("usage: %s <log.bin> [output.txt]\n", argv[0]);
+        return -1;
+    }
+
+    FILE* pFile = fopen(argv[1], "rb");
+    if (!pFile)
+    {
+        printf("can't open a binary log: %s\n", argv[1]);
+        return -1;
+    }
+
+    char     magic[sizeof(LOG_BIN_MAGIC)];
+    uint32_t clocksPerSec = 0;
+
+    if (fread(magic, 1, sizeof(magic), pFile) != sizeof(magic) ||
+        memcmp(magic, LOG_BIN_MAGIC, sizeof(magic)) != 0 ||
+        !Read(pFile, clocksPerSec))
+    {
+        printf("it isn't a binary log of the engine: %s\n", argv[1]);
+        fclose(pFile);
+        return -1;
+    }
+
+    FILE* pOut = (argc > 2) ? fopen(argv[2], "w") : stdout;
+    if (!pOut)
+    {
+        printf("can't create an output file: %s\n", argv[2]);
+        fclose(pFile);
+        return -1;
+    }
+
+    std::vector<Site> sites;
+    std::vector<char> args;
+    char              text[512];
+    uint32_t          numMessages = 0;
+    bool              isBroken    = false;
+    uint8_t           tag         = 0;
+
+    while (Read(pFile, tag))
+    {
+        if (tag == LOG_BIN_SITE)
+        {
+            uint32_t id = 0;
+            Site     site;
+
+            if (!Read(pFile, id)            ||
+                !Read(pFile, site.type)     ||
+                !Read(pFile, site.codeLine) ||
+                !ReadStr(pFile, site.fileName) ||
+                !ReadStr(pFile, site.funcName) ||
+                !ReadStr(pFile, site.format)   ||
+                id != sites.size())
+            {
+                isBroken = true;
+                break;
+            }
+
+            sites.push_back(site);
+        }
+        else if (tag == LOG_BIN_MSG)
+        {
+            uint32_t id       = 0;
+            int64_t  clock    = 0;
+            uint16_t argsSize = 0;
+
+            if (!Read(pFile, id) || !Read(pFile, clock) || !Read(pFile, argsSize) || id >= sites.size())
+            {
+                isBroken = true;
+                break;
+            }
+
+            args.resize(argsSize);
+
+            if (argsSize > 0 && fread(args.data(), 1, argsSize, pFile) != argsSize)
+            {
+                isBroken = true;
+                break;
+            }
+
+            LogArgReader r;
+            r.pBuf = args.data();
+            r.size = argsSize;
+
+            LogFormatArgs(sites[id].format.c_str(), r, text, sizeof(text));
+            PrintMessage(pOut, sites[id], (long)clock, text);
+            numMessages++;
+        }
+        else
+        {
+            isBroken = true;
+            break;
+        }
+    }
+
+    if (isBroken)
+        fprintf(stderr, "the binary log is broken or truncated after %u messages\n", numMessages);
+
+    fprintf(stderr, "decoded: %u messages of %u sites\n", numMessages, (uint32_t)sites.size());
+
+    if (pOut != stdout)
+        fclose(pOut);
+
+    fclose(pFile);
+    return (isBroken) ? -1 : 0;
+}